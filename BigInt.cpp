@@ -23,53 +23,514 @@
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
+/*
+    Limbs
+    -----
+    The magnitude of a BigInt is stored in base 2^64, one `limb_t` per digit,
+    least significant limb first. Zero is represented by an empty vector, so a
+    normalized magnitude never has a zero limb at the top.
+
+    Limbs is a small vector: values of up to INLINE_LIMBS limbs (128 bits)
+    live inside the object itself and only larger values move to the heap,
+    so counters and other small BigInts never allocate.
+
+    A copy of a value with at least COPY_ON_WRITE_THRESHOLD limbs shares the
+    heap buffer of the original, which is reference counted, and the first
+    write to either of them (through any non-const accessor) gives it a
+    private copy. Only buffers from new[] or from the allocator current on
+    the copying thread are shared; others are copied. Set the threshold to
+    SIZE_MAX to always copy.
+*/
+
+typedef uint64_t limb_t;
+typedef unsigned __int128 dlimb_t;
+
+
+/*
+    BigIntAllocator
+    ---------------
+    Heap buffers of Limbs come from the allocator that is current on the
+    calling thread when the buffer is allocated, and go back to the same
+    allocator when it is freed, whatever thread that happens on. By default
+    there is no current allocator and buffers use new[] and delete[].
+
+    Make an allocator current for a block of code with BigIntAllocatorScope.
+    Every BigInt allocated inside the block uses it. The temporaries of the
+    kernels (multiplication, squaring, division and modular powers) don't:
+    they always come from the scratch pool of the thread.
+
+        BigIntArena arena;
+        {
+            BigIntAllocatorScope scope(arena);
+            ... // the BigInts made here are bump allocated from the arena
+        }
+        arena.reset(); // frees all of it at once
+
+    Because the current allocator is per thread, threads that each use their
+    own arena never meet in the global allocator.
+*/
+
+class BigIntAllocator
+{
+public:
+    virtual ~BigIntAllocator() {}
+
+    // Returns storage for n limbs, aligned for limb_t
+    virtual limb_t *allocate(size_t n) = 0;
+    // p and n are as returned by and passed to allocate()
+    virtual void deallocate(limb_t *p, size_t n) = 0;
+};
+
+inline BigIntAllocator *&current_bigint_allocator()
+{
+    static thread_local BigIntAllocator *current = nullptr;
+    return current;
+}
+
+// Makes an allocator current on this thread until the end of the scope. A
+// null allocator selects new[] and delete[].
+class BigIntAllocatorScope
+{
+public:
+    explicit BigIntAllocatorScope(BigIntAllocator *allocator)
+        : previous(current_bigint_allocator())
+    {
+        current_bigint_allocator() = allocator;
+    }
+
+    explicit BigIntAllocatorScope(BigIntAllocator &allocator)
+        : BigIntAllocatorScope(&allocator) {}
+
+    ~BigIntAllocatorScope() { current_bigint_allocator() = previous; }
+
+    BigIntAllocatorScope(const BigIntAllocatorScope &) = delete;
+    BigIntAllocatorScope &operator=(const BigIntAllocatorScope &) = delete;
+
+private:
+    BigIntAllocator *previous;
+};
+
+
+/*
+    BigIntArena
+    -----------
+    A bump allocator for the results of batches of computations.
+    deallocate() only gives memory back when it frees the most recent block,
+    which covers short lived values such as the temporaries of an expression;
+    everything else is released together by reset(), which keeps the chunks
+    for the next batch, or by the destructor.
+
+    A BigInt whose buffer lives in the arena must not be used after reset().
+    To keep a result, copy it after the scope of the arena has ended: the copy
+    is allocated from the allocator that is current at that point. (A move
+    keeps the buffer, so it doesn't help.)
+
+    An arena is not synchronized. Use one per thread, and keep the values in
+    it, and their copies made inside its scope (which share its buffers), on
+    that thread.
+*/
+
+class BigIntArena : public BigIntAllocator
+{
+public:
+    explicit BigIntArena(size_t chunk_size = 1 << 15)
+        : chunk_limbs(chunk_size ? chunk_size : 1), chunk(0), offset(0) {}
+
+    ~BigIntArena()
+    {
+        for (Chunk &c : chunks)
+            delete[] c.limbs;
+    }
+
+    BigIntArena(const BigIntArena &) = delete;
+    BigIntArena &operator=(const BigIntArena &) = delete;
+
+    limb_t *allocate(size_t n) override
+    {
+        while (chunk < chunks.size() && offset + n > chunks[chunk].size)
+        {
+            chunk++;
+            offset = 0;
+        }
+        if (chunk == chunks.size())
+        {
+            // Each new chunk is at least as large as all previous ones together
+            size_t size = std::max(n, chunk_limbs);
+            for (const Chunk &c : chunks)
+                size = std::max(size, c.size * 2);
+            chunks.push_back(Chunk{new limb_t[size], size});
+            offset = 0;
+        }
+
+        limb_t *p = chunks[chunk].limbs + offset;
+        offset += n;
+        return p;
+    }
+
+    void deallocate(limb_t *p, size_t n) override
+    {
+        if (chunk < chunks.size() && p + n == chunks[chunk].limbs + offset)
+            offset -= n;
+    }
+
+    // Releases every block allocated so far, keeping the chunks for reuse
+    void reset()
+    {
+        chunk = 0;
+        offset = 0;
+    }
+
+    // Limbs held by the chunks of the arena
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const Chunk &c : chunks)
+            total += c.size;
+        return total;
+    }
+
+private:
+    struct Chunk
+    {
+        limb_t *limbs;
+        size_t size;
+    };
+
+    size_t chunk_limbs;
+    std::vector<Chunk> chunks;
+    size_t chunk;  // chunk that is bump allocated from
+    size_t offset; // limbs of that chunk in use
+};
+
+
+size_t COPY_ON_WRITE_THRESHOLD = 64;
+
+class Limbs
+{
+public:
+    static const size_t INLINE_LIMBS = 2;
+
+    Limbs() : used(0), capacity(INLINE_LIMBS) {}
+
+    explicit Limbs(size_t n, limb_t value = 0) : used(0), capacity(INLINE_LIMBS)
+    {
+        reserve(n);
+        std::fill(data(), data() + n, value);
+        used = n;
+    }
+
+    Limbs(const Limbs &other) : used(0), capacity(INLINE_LIMBS)
+    {
+        if (other.shareable())
+        {
+            share(other);
+            return;
+        }
+        reserve(other.used);
+        std::copy(other.data(), other.data() + other.used, data());
+        used = other.used;
+    }
+
+    // A copy in a buffer of its own with room for n limbs, for a copy that
+    // is about to be modified
+    Limbs(const Limbs &other, size_t n) : used(0), capacity(INLINE_LIMBS)
+    {
+        reserve(std::max(n, other.used));
+        std::copy(other.data(), other.data() + other.used, data());
+        used = other.used;
+    }
+
+    Limbs(Limbs &&other) noexcept : used(0), capacity(INLINE_LIMBS)
+    {
+        steal(other);
+    }
+
+    Limbs &operator=(const Limbs &other)
+    {
+        if (this != &other)
+        {
+            if (other.shareable())
+            {
+                if (is_inline() || storage.heap != other.storage.heap)
+                {
+                    release();
+                    share(other);
+                }
+                used = other.used;
+                return *this;
+            }
+            used = 0;
+            reserve(other.used);
+            std::copy(other.data(), other.data() + other.used, data());
+            used = other.used;
+        }
+        return *this;
+    }
+
+    Limbs &operator=(Limbs &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~Limbs() { release(); }
+
+    size_t size() const { return used; }
+    bool empty() const { return used == 0; }
+    bool is_inline() const { return capacity == INLINE_LIMBS; }
+
+    bool is_shared() const
+    {
+        return capacity >= MIN_SHARED_LIMBS &&
+               references().load(std::memory_order_acquire) != 1;
+    }
+
+    limb_t *data()
+    {
+        if (is_inline())
+            return storage.inline_limbs;
+        if (__builtin_expect(is_shared(), 0))
+            unshare();
+        return storage.heap;
+    }
+    const limb_t *data() const { return is_inline() ? storage.inline_limbs : storage.heap; }
+
+    limb_t &operator[](size_t i) { return data()[i]; }
+    const limb_t &operator[](size_t i) const { return data()[i]; }
+    limb_t &back() { return data()[used - 1]; }
+    const limb_t &back() const { return data()[used - 1]; }
+
+    limb_t *begin() { return data(); }
+    limb_t *end() { return data() + used; }
+    const limb_t *begin() const { return data(); }
+    const limb_t *end() const { return data() + used; }
+
+    void clear() { used = 0; }
+    void pop_back() { used--; }
+
+    void push_back(limb_t value)
+    {
+        if (used == capacity)
+            reserve(capacity * 2);
+        data()[used++] = value;
+    }
+
+    // New limbs are zero filled
+    void resize(size_t n)
+    {
+        reserve(n);
+        if (n > used)
+            std::fill(data() + used, data() + n, 0);
+        used = n;
+    }
+
+    // Also makes a shared buffer private
+    void reserve(size_t n)
+    {
+        if (n <= capacity && !is_shared())
+            return;
+
+        n = std::max(n, capacity);
+        limb_t *grown = allocate(n);
+        const Limbs &self = *this;
+        std::copy(self.data(), self.data() + used, grown);
+        release();
+        storage.heap = grown;
+        capacity = n;
+    }
+
+private:
+    union Storage
+    {
+        limb_t inline_limbs[INLINE_LIMBS];
+        limb_t *heap;
+    } storage;
+    size_t used;
+    size_t capacity;
+
+    // A heap buffer is preceded by HEADER_LIMBS limbs, holding the allocator
+    // it came from, so that it can be freed under any current allocator, and
+    // the number of Limbs that share it.
+    static const size_t HEADER_LIMBS = 2;
+    typedef std::atomic<size_t> RefCount;
+
+    // Smaller buffers are never shared, which spares them the reference
+    // count checks
+    static const size_t MIN_SHARED_LIMBS = 16;
+
+    __attribute__((noinline)) void unshare() { reserve(capacity); }
+
+    static limb_t *allocate(size_t n)
+    {
+        BigIntAllocator *allocator = current_bigint_allocator();
+        size_t size = n + HEADER_LIMBS;
+        limb_t *block = allocator ? allocator->allocate(size) : new limb_t[size];
+        block[0] = reinterpret_cast<uintptr_t>(allocator);
+        new (block + 1) RefCount(1);
+        return block + HEADER_LIMBS;
+    }
+
+    RefCount &references() const
+    {
+        return *reinterpret_cast<RefCount *>(storage.heap - 1);
+    }
+
+    static BigIntAllocator *owner(const limb_t *heap)
+    {
+        return reinterpret_cast<BigIntAllocator *>(
+            static_cast<uintptr_t>(*(heap - HEADER_LIMBS)));
+    }
+
+    // A buffer from another allocator than the current one is copied, so a
+    // copy made after the scope of an arena doesn't point into the arena
+    bool shareable() const
+    {
+        if (used < MIN_SHARED_LIMBS || used < COPY_ON_WRITE_THRESHOLD)
+            return false;
+        BigIntAllocator *allocator = owner(storage.heap);
+        return !allocator || allocator == current_bigint_allocator();
+    }
+
+    // *this must not own a heap buffer
+    void share(const Limbs &other)
+    {
+        other.references().fetch_add(1, std::memory_order_relaxed);
+        storage.heap = other.storage.heap;
+        used = other.used;
+        capacity = other.capacity;
+    }
+
+    void release()
+    {
+        // a count of one can't change under us, so the atomic decrement is
+        // only needed for a shared buffer
+        if (!is_inline() && (capacity < MIN_SHARED_LIMBS ||
+                             references().load(std::memory_order_acquire) == 1 ||
+                             references().fetch_sub(1, std::memory_order_acq_rel) == 1))
+        {
+            limb_t *block = storage.heap - HEADER_LIMBS;
+            BigIntAllocator *allocator = owner(storage.heap);
+            if (allocator)
+                allocator->deallocate(block, capacity + HEADER_LIMBS);
+            else
+                delete[] block;
+        }
+        capacity = INLINE_LIMBS;
+    }
+
+    // Take over the contents of other, which is left empty. *this must not
+    // own a heap buffer.
+    void steal(Limbs &other)
+    {
+        used = other.used;
+        capacity = other.capacity;
+        if (other.is_inline())
+            std::copy(other.storage.inline_limbs, other.storage.inline_limbs + used,
+                      storage.inline_limbs);
+        else
+            storage.heap = other.storage.heap;
+
+        other.used = 0;
+        other.capacity = INLINE_LIMBS;
+    }
+};
+
+
+template <class Op, class L, class R>
+struct BigIntExpr;
+
+template <size_t Bits>
+class FixedBigInt;
+
+template <char... Digits>
+struct BigIntLiteral;
+
+struct GcdMatrix;
+
 class BigInt
 {
 private:
-    std::string bigInteger;
-    short sign;
+    Limbs magnitude;
+    short signum;
 
 public:
     // Constructors:
     BigInt();
     BigInt(const BigInt &);
+    BigInt(BigInt &&) noexcept;
     BigInt(const long long &);
     BigInt(const std::string &);
 
     // Assignment operators:
     BigInt& operator=(const BigInt &);
+    BigInt& operator=(BigInt &&) noexcept;
     BigInt& operator=(const long long &);
     BigInt& operator=(const std::string &);
 
     // Unary arithmetic operators:
     BigInt operator+() const; // unary +
-    BigInt operator-() const; // unary -
+    BigInt operator-() const &; // unary -
+    BigInt operator-() &&;
 
     // Binary arithmetic operators:
-    BigInt operator+(BigInt obj);
-    BigInt operator-(BigInt obj);
-    BigInt operator*(BigInt obj);
-    BigInt operator/(BigInt obj);
-    BigInt operator%(BigInt obj);
-    BigInt operator+(const long long &);
-    BigInt operator-(const long long &);
-    BigInt operator*(const long long &);
-    BigInt operator/(const long long &);
-    BigInt operator%(const long long &);
-    BigInt operator+(const std::string &);
-    BigInt operator-(const std::string &);
-    BigInt operator*(const std::string &);
-    BigInt operator/(const std::string &);
-    BigInt operator%(const std::string &);
+    // The && overloads are chosen when an operand is a temporary, and build
+    // the result in that operand's buffer instead of a new one.
+    BigInt operator+(const BigInt &) const &;
+    BigInt operator+(const BigInt &) &&;
+    BigInt operator+(BigInt &&) const &;
+    BigInt operator+(BigInt &&) &&;
+    BigInt operator-(const BigInt &) const &;
+    BigInt operator-(const BigInt &) &&;
+    BigInt operator-(BigInt &&) const &;
+    BigInt operator-(BigInt &&) &&;
+    BigInt operator*(const BigInt &) const;
+    BigInt operator/(const BigInt &) const;
+    BigInt operator%(const BigInt &) const;
+    BigInt operator+(const long long &) const &;
+    BigInt operator+(const long long &) &&;
+    BigInt operator-(const long long &) const &;
+    BigInt operator-(const long long &) &&;
+    BigInt operator*(const long long &) const &;
+    BigInt operator*(const long long &) &&;
+    BigInt operator/(const long long &) const &;
+    BigInt operator/(const long long &) &&;
+    BigInt operator%(const long long &) const;
+    BigInt operator+(const std::string &) const;
+    BigInt operator-(const std::string &) const;
+    BigInt operator*(const std::string &) const;
+    BigInt operator/(const std::string &) const;
+    BigInt operator%(const std::string &) const;
+    BigInt square() const;
+    BigInt &addmul(const BigInt &, const BigInt &);
+    BigInt &submul(const BigInt &, const BigInt &);
+    BigInt &addmul(const BigInt &, const long long &);
+    BigInt &submul(const BigInt &, const long long &);
+    std::pair<BigInt, BigInt> divmod(const BigInt &) const;
+    std::pair<BigInt, BigInt> floor_divmod(const BigInt &) const;
 
     // Arithmetic-assignment operators:
-    BigInt operator+=(BigInt &obj);
-    BigInt operator-=(BigInt &obj);
-    BigInt operator*=(BigInt &obj);
-    BigInt operator/=(BigInt &obj);
-    BigInt operator%=(BigInt &obj);
+    BigInt &operator+=(const BigInt &);
+    BigInt &operator-=(const BigInt &);
+    BigInt &operator*=(const BigInt &);
+    BigInt &operator/=(const BigInt &);
+    BigInt &operator%=(const BigInt &);
     BigInt &operator+=(const long long &);
     BigInt &operator-=(const long long &);
     BigInt &operator*=(const long long &);
@@ -82,53 +543,104 @@ public:
     BigInt &operator%=(const std::string &);
 
     // Increment and decrement operators:
-    BigInt operator++();    // Pre-increment
+    BigInt &operator++();   // Pre-increment
     BigInt operator++(int); // Post-increment
-    BigInt operator--();    // Pre-decrement
+    BigInt &operator--();   // Pre-decrement
     BigInt operator--(int); // Post-decrement
 
+    // Bit shift operators:
+    BigInt operator<<(size_t) const;
+    BigInt operator>>(size_t) const;
+    BigInt &operator<<=(size_t);
+    BigInt &operator>>=(size_t);
+
     // Relational operators:
-    bool operator>(BigInt &obj);
-    bool operator<(BigInt &obj);
-    bool operator==(BigInt &obj);
-    bool operator>=(BigInt &obj);
-    bool operator<=(BigInt &obj);
-    bool operator!=(BigInt &obj);
-    bool operator<(const long long &);
-    bool operator>(const long long &);
-    bool operator<=(const long long &);
-    bool operator>=(const long long &);
-    bool operator==(const long long &);
-    bool operator!=(const long long &);
-    bool operator<(const std::string &);
-    bool operator>(const std::string &);
-    bool operator<=(const std::string &);
-    bool operator>=(const std::string &);
-    bool operator==(const std::string &);
-    bool operator!=(const std::string &);
+    bool operator>(const BigInt &) const;
+    bool operator<(const BigInt &) const;
+    bool operator==(const BigInt &) const;
+    bool operator>=(const BigInt &) const;
+    bool operator<=(const BigInt &) const;
+    bool operator!=(const BigInt &) const;
+    bool operator<(const long long &) const;
+    bool operator>(const long long &) const;
+    bool operator<=(const long long &) const;
+    bool operator>=(const long long &) const;
+    bool operator==(const long long &) const;
+    bool operator!=(const long long &) const;
+    bool operator<(const std::string &) const;
+    bool operator>(const std::string &) const;
+    bool operator<=(const std::string &) const;
+    bool operator>=(const std::string &) const;
+    bool operator==(const std::string &) const;
+    bool operator!=(const std::string &) const;
 
     // I/O stream operators:
     friend std::istream &operator>>(std::istream &, BigInt &);
     friend std::ostream &operator<<(std::ostream &, const BigInt &);
 
+    // Exponentiation:
+    friend BigInt pow(const BigInt &, unsigned long long);
+    friend BigInt powmod(const BigInt &, const BigInt &, const BigInt &);
+
+    // Number theory:
+    friend BigInt gcd(const BigInt &, const BigInt &);
+    friend BigInt lcm(const BigInt &, const BigInt &);
+    friend BigInt gcdext(const BigInt &, const BigInt &, BigInt &, BigInt &);
+    friend BigInt invmod(const BigInt &, const BigInt &);
+
     // Conversion functions:
     std::string to_string() const;
     int to_int() const;
     long to_long() const;
     long long to_long_long() const;
-    
+
     //Function
-    int length();
+    int length() const;
+    bool is_zero() const;
+    bool is_one() const;
+    int sign() const;
 
     // Logical operators overload
-    bool operator&&(BigInt &obj);
-    bool operator||(BigInt &obj);
-    bool operator!();
+    bool operator&&(const BigInt &obj) const;
+    bool operator||(const BigInt &obj) const;
+    bool operator!() const;
 
     // Array subscript operator overload
-    BigInt operator[](int index);
+    BigInt operator[](int index) const;
+
+    // Expression templates, see lazy():
+    template <class Op, class L, class R>
+    BigInt(const BigIntExpr<Op, L, R> &);
+    template <class Op, class L, class R>
+    BigInt &operator=(const BigIntExpr<Op, L, R> &);
+    template <class Op, class L, class R>
+    BigInt &operator+=(const BigIntExpr<Op, L, R> &);
+    template <class Op, class L, class R>
+    BigInt &operator-=(const BigIntExpr<Op, L, R> &);
 
     ~BigInt();
+
+private:
+    template <class Op, class L, class R>
+    friend struct BigIntExpr;
+    template <size_t Bits>
+    friend class FixedBigInt;
+    template <char... Digits>
+    friend struct BigIntLiteral;
+    friend class ModContext;
+    friend size_t bit_length(const BigInt &);
+    friend dlimb_t top_bits(const BigInt &, size_t);
+    friend void gcd_lehmer_apply(BigInt &, BigInt &, const limb_t (&)[4]);
+    friend bool gcd_step(BigInt &, BigInt &, const BigInt &, GcdMatrix *);
+
+    BigInt(const BigInt &, size_t capacity);
+
+    // Fused kernels used by addmul/submul, *= and the expression templates.
+    // *this must not be one of the operands of assign_product_mod.
+    void assign_product(const BigInt &, const BigInt &);
+    void add_product(const BigInt &, const BigInt &, bool subtract);
+    void add_product(const limb_t *, size_t, const limb_t *, size_t, short product_sign);
+    void assign_product_mod(const BigInt &, const BigInt &, const BigInt &);
 };
 
 
@@ -139,64 +651,83 @@ public:
 */
 
 /*
-    Swaping
-    -------
-    swaping s1 with s2 and len1 with len2
+    strip_leading_zeroes
+    --------------------
+    Strip the zero limbs from the top of a magnitude, so that zero becomes
+    the empty vector.
 */
 
-void swaping(std::string &s1, std::string &s2, int &len1, int &len2)
+void strip_leading_zeroes(Limbs &num)
 {
-    std::string tempStr = s1;
-    s1 = s2;
-    s2 = tempStr;
-
-    int tempInt = len1;
-    len1 = len2;
-    len2 = tempInt;
+    // reads through const, so that a shared buffer stays shared
+    const Limbs &limbs = num;
+    while (!num.empty() && limbs.back() == 0)
+        num.pop_back();
 }
 
 /*
-    strip_leading_zeroes
-    --------------------
-    Strip the leading zeroes from a number represented as a string.
+    Compare two magnitudes
+    ----------------------
+    Returns 1, 0 or -1.
+    Note: only compare with magnitude value not sign
 */
 
-void strip_leading_zeroes(std::string &num)
+int magnitude_compare(const Limbs &a, const Limbs &b)
 {
-    size_t i;
-    for (i = 0; i < num.size(); i++)
+    if (a.size() != b.size())
+        return a.size() > b.size() ? 1 : -1;
+
+    for (size_t i = a.size(); i-- > 0;)
     {
-        if(num[i] != '0')
-            break;
+        if (a[i] != b[i])
+            return a[i] > b[i] ? 1 : -1;
     }
-
-    if(i == num.size())
-        num = "0";
-    else
-        num = num.substr(i);
-    
+    return 0;
 }
 
 /*
-    Compare with two string
+    Magnitude of an integer
     -----------------------
-    swaping s1 with s2
-    Note: only compare with magnitude value not sign
+    |num| as a limb, negated through unsigned arithmetic so that LLONG_MIN
+    does not overflow.
+*/
+
+constexpr limb_t integer_magnitude(const long long &num)
+{
+    return num < 0 ? 0 - (limb_t)num : (limb_t)num;
+}
+
+/*
+    Small values
+    ------------
+    A magnitude of at most two limbs fits in a dlimb_t, so the kernels can
+    handle it with native 128-bit arithmetic and only fall back to the limb
+    loops when a result overflows.
 */
 
-int string_compare(std::string &s1, std::string &s2)
+bool is_small(const Limbs &num)
 {
-    int len1 = s1.length();
-    int len2 = s2.length();
+    return num.size() <= 2;
+}
 
-    if (len1 > len2)
-        return 1;
-    else if (len1 < len2)
-        return -1;
-    else
-    {
-        return s1.compare(s2);
-    }
+dlimb_t limbs_to_dlimb(const Limbs &num)
+{
+    dlimb_t value = 0;
+    if (num.size() > 1)
+        value = (dlimb_t)num[1] << 64;
+    if (!num.empty())
+        value |= num[0];
+    return value;
+}
+
+Limbs dlimb_to_limbs(dlimb_t value)
+{
+    Limbs result;
+    if (value)
+        result.push_back((limb_t)value);
+    if (value >> 64)
+        result.push_back((limb_t)(value >> 64));
+    return result;
 }
 
 /*
@@ -215,1315 +746,6000 @@ bool is_valid_number(const std::string &num)
     return true;
 }
 
-/*
-    Return size of bigint
-    ---------------------
-*/
-
-int BigInt::length()
-{
-    return this->bigInteger.length();
-}
 
 /*
     ===========================================================================
-    Conversion functions for BigInt
+    Limb kernels
     ===========================================================================
+    Low level loops over raw limb arrays, least significant limb first. The
+    destination may alias a source operand when it starts at the same limb.
+    Carries and borrows are returned to the caller. The kernels are
+    constexpr, so FixedBigInt can also run them at compile time.
 */
 
 /*
-    to_string
-    ---------
-    Converts a BigInt to a string.
+    cmp_n
+    -----
+    Compare a[0..n) with b[0..n), returns 1, 0 or -1.
 */
 
-std::string BigInt::to_string() const
+constexpr int cmp_n(const limb_t *a, const limb_t *b, size_t n)
 {
-    // prefix with sign if negative
-    return this->sign == '-' ? "-" + this->bigInteger : this->bigInteger;
+    for (size_t i = n; i-- > 0;)
+    {
+        if (a[i] != b[i])
+            return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
 }
 
 /*
-    to_int
-    ------
-    Converts a BigInt to an int.
-    NOTE: If the BigInt is out of range of an int, stoi() will throw an
-    out_of_range exception.
+    add_n
+    -----
+    r[0..n) = a[0..n) + b[0..n), returns the carry out.
 */
 
-int BigInt::to_int() const
+constexpr limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n)
 {
-    return std::stoi(this->to_string());
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        limb_t sum = a[i] + carry;
+        carry = (sum < carry);
+        limb_t y = b[i];
+        sum += y;
+        carry += (sum < y);
+        r[i] = sum;
+    }
+    return carry;
 }
 
 /*
-    to_long
-    -------
-    Converts a BigInt to a long int.
-    NOTE: If the BigInt is out of range of a long int, stol() will throw an
-    out_of_range exception.
+    add_1
+    -----
+    r[0..n) = a[0..n) + b, returns the carry out.
 */
 
-long BigInt::to_long() const
+constexpr limb_t add_1(limb_t *r, const limb_t *a, size_t n, limb_t b)
 {
-    return std::stol(this->to_string());
+    size_t i = 0;
+    for (; i < n && b; i++)
+    {
+        limb_t sum = a[i] + b;
+        b = (sum < b);
+        r[i] = sum;
+    }
+    if (r != a)
+    {
+        for (; i < n; i++)
+            r[i] = a[i];
+    }
+    return b;
 }
 
 /*
-    to_long_long
-    ------------
-    Converts a BigInt to a long long int.
-    NOTE: If the BigInt is out of range of a long long int, stoll() will throw
-    an out_of_range exception.
+    add
+    ---
+    r[0..an) = a[0..an) + b[0..bn) with an >= bn, returns the carry out.
 */
 
-long long BigInt::to_long_long() const
+constexpr limb_t add(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
 {
-    return std::stoll(this->to_string());
+    limb_t carry = add_n(r, a, b, bn);
+    return add_1(r + bn, a + bn, an - bn, carry);
 }
 
 /*
-    Addition
-    --------
-    string = string + string
+    sub_n
+    -----
+    r[0..n) = a[0..n) - b[0..n), returns the borrow out.
 */
 
-std::string addition(std::string s1, std::string s2)
+constexpr limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n)
 {
-
-    /**
-     * Complexity of addition function
-     * 
-     * Time complexity : O(n)
-     * Space complexity: O(n)
-     * 
-     * Algorithm of addition function
-     *      1. Input two string
-     *      2. Calculate length of two string
-     *      3. Make sure length of s1 is larger
-     *      4. First loop will circulate by s1 length which is smaller
-     *      5. Second loop will circulate by s2 length which is larger(Add remaining digit)
-     *      6. Reverse the resultant string
-     *      7. return the resultant string
-     */
-
-    // Calculate length of both string
-    int len1 = s1.length();
-    int len2 = s2.length();
-
-    // Before proceeding further, make sure length of s1 is larger.
-    if (len1 < len2)
+    limb_t borrow = 0;
+    for (size_t i = 0; i < n; i++)
     {
-        swaping(s1, s2, len1, len2);
+        limb_t x = a[i], y = b[i];
+        limb_t diff = x - y;
+        limb_t out = (x < y);
+        out |= (diff < borrow);
+        r[i] = diff - borrow;
+        borrow = out;
     }
+    return borrow;
+}
 
-    int diff = len1 - len2;
-
-    // Take an empty string for storing result
-    std::string result;
-
-    // Initially take carry zero
-    int carry = 0;
-
-    for (int i = len2 - 1; i >= 0; i--)
-    {
-        // Do school mathematics, compute sum of current digit and carry
-        int sum = ((s1[i + diff] - '0') + (s2[i] - '0') + carry);
-        result.push_back(sum % 10 + '0');
-        carry = sum / 10;
-    }
+/*
+    sub_1
+    -----
+    r[0..n) = a[0..n) - b, returns the borrow out.
+*/
 
-    // Add remaining digits of s1
-    for (int i = len1 - len2 - 1; i >= 0; i--)
+constexpr limb_t sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b)
+{
+    size_t i = 0;
+    for (; i < n && b; i++)
     {
-        int sum = (s1[i] - '0') + carry;
-        result.push_back(sum % 10 + '0');
-        carry = sum / 10;
+        limb_t x = a[i];
+        r[i] = x - b;
+        b = (x < b);
     }
-
-    // Add remaining carry
-    if (carry)
+    if (r != a)
     {
-        result.push_back(carry + '0');
+        for (; i < n; i++)
+            r[i] = a[i];
     }
+    return b;
+}
 
-    // reverse resultant string
-    reverse(result.begin(), result.end());
+/*
+    sub
+    ---
+    r[0..an) = a[0..an) - b[0..bn) with an >= bn, returns the borrow out.
+*/
 
-    return result;
+constexpr limb_t sub(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    limb_t borrow = sub_n(r, a, b, bn);
+    return sub_1(r + bn, a + bn, an - bn, borrow);
 }
 
 /*
-    subtraction
-    --------
-    string = string - string
+    mul_1
+    -----
+    r[0..n) = a[0..n) * b, returns the high limb.
 */
 
-std::string subtraction(std::string s1, std::string s2)
+constexpr limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t b)
 {
-    /**
-     * Complexity of addition function
-     * 
-     * Time complexity : O(n)
-     * Space complexity: O(n)
-     * 
-     * Algorithm of addition function
-     *      1. Input two string
-     *      2. Calculate length of two string
-     *      3. Make sure s1 is larger than s2
-     *      4. Calculate the difference
-     *      5. circulate the loop by s2.length() and do school mathematics
-     *      6. Circulate the another loop by s1.length() substraction exiesting value with carry
-     *      7. Reverse the resultant string
-     *      8. If result string head is zero then remove it
-     *      9. Return the result string
-     */
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        dlimb_t product = (dlimb_t)a[i] * b + carry;
+        r[i] = (limb_t)product;
+        carry = (limb_t)(product >> 64);
+    }
+    return carry;
+}
+
+/*
+    addmul_1
+    --------
+    r[0..n) += a[0..n) * b, returns the high limb.
+*/
+
+constexpr limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t b)
+{
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        dlimb_t product = (dlimb_t)a[i] * b + r[i] + carry;
+        r[i] = (limb_t)product;
+        carry = (limb_t)(product >> 64);
+    }
+    return carry;
+}
 
-    // Calculate length of both string
-    int len1 = s1.length();
-    int len2 = s2.length();
-    // cout << "\n\n";
+/*
+    submul_1
+    --------
+    r[0..n) -= a[0..n) * b, returns the limb borrowed out of the top.
+*/
 
-    // Before proceeding further, make sure s1 is larger than s2.
-    if (len1 < len2)
+constexpr limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t b)
+{
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
     {
-        swaping(s1, s2, len1, len2);
+        dlimb_t product = (dlimb_t)a[i] * b + carry;
+        limb_t low = (limb_t)product;
+        carry = (limb_t)(product >> 64);
+        limb_t x = r[i];
+        r[i] = x - low;
+        carry += (x < low);
     }
-    else if (len1 == len2)
+    return carry;
+}
+
+/*
+    divrem_1
+    --------
+    q[0..n) = a[0..n) / d, returns a[0..n) % d. q may alias a.
+*/
+
+constexpr limb_t divrem_1(limb_t *q, const limb_t *a, size_t n, limb_t d)
+{
+    limb_t rem = 0;
+    for (size_t i = n; i-- > 0;)
     {
-        int val = s1.compare(s2);
-        if (val == -1)
-        {
-            swap(s1, s2);
-        }
-        else if (val == 0)
-        {
-            return "0";
-        }
+        dlimb_t cur = ((dlimb_t)rem << 64) | a[i];
+        q[i] = (limb_t)(cur / d);
+        rem = (limb_t)(cur % d);
     }
+    return rem;
+}
 
-    int diff = len1 - len2;
+/*
+    mod_1
+    -----
+    Returns a[0..n) % d, without writing a quotient.
+*/
 
-    // Take an empty string for storing result
-    std::string result;
+constexpr limb_t mod_1(const limb_t *a, size_t n, limb_t d)
+{
+    limb_t rem = 0;
+    for (size_t i = n; i-- > 0;)
+        rem = (limb_t)((((dlimb_t)rem << 64) | a[i]) % d);
+    return rem;
+}
 
-    // Initially take carry zero
-    int carry = 0;
+/*
+    lshift / rshift
+    ---------------
+    Shift a[0..n) by 0 < cnt < 64 bits into r[0..n) and return the bits
+    shifted out (in the low bits for lshift, the high bits for rshift).
+*/
 
-    for (int i = len2 - 1; i >= 0; i--)
+constexpr limb_t lshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt)
+{
+    limb_t out = 0;
+    for (size_t i = 0; i < n; i++)
     {
-        // Do school mathematics, compute sum of current digit and carry
-        int n1 = (s1[i + diff] - '0');
-        int n2 = (s2[i] - '0') + carry;
-
-        if (n1 < n2)
-        {
-            n1 += 10;
-            carry = 1;
-        }
-        else
-        {
-            carry = 0;
-        }
+        limb_t x = a[i];
+        r[i] = (x << cnt) | out;
+        out = x >> (64 - cnt);
+    }
+    return out;
+}
 
-        result.push_back((n1 - n2) + '0');
+constexpr limb_t rshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt)
+{
+    limb_t out = 0;
+    for (size_t i = n; i-- > 0;)
+    {
+        limb_t x = a[i];
+        r[i] = (x >> cnt) | out;
+        out = x << (64 - cnt);
     }
+    return out;
+}
+
+
+
+/*
+    ===========================================================================
+    Scratch space
+    ===========================================================================
+    The multiplication and division kernels keep their temporaries in Limbs
+    allocated from a per thread ScratchPool, which they make the current
+    allocator while they run. A freed block stays in the pool for the next
+    temporary of about the same size, so once the pool has grown to the
+    high-water mark of a workload the kernels no longer allocate.
+
+    Nothing allocated from the pool may outlive the kernel, since the pool
+    belongs to its thread: results are always written to buffers that the
+    caller allocated.
+*/
+
+class ScratchPool : public BigIntAllocator
+{
+public:
+    ScratchPool() : cached(0), limit(std::numeric_limits<size_t>::max()) {}
+    ~ScratchPool() { trim(0); }
 
-    // Add remaining digits of s1
-    for (int i = (len1 - len2 - 1); i >= 0; i--)
+    limb_t *allocate(size_t n) override
     {
-        int n1 = (s1[i] - '0');
-        // int n2 = (s2[i] - '0') + carry;
+        size_t c = size_class(n);
+        if (free_blocks[c].empty())
+            return new limb_t[block_size(n)];
+
+        limb_t *p = free_blocks[c].back();
+        free_blocks[c].pop_back();
+        cached -= block_size(n);
+        return p;
+    }
 
-        if (n1 < carry)
+    void deallocate(limb_t *p, size_t n) override
+    {
+        size_t size = block_size(n);
+        if (cached + size > limit)
         {
-            n1 += 10;
-            // carry = 1;
-            result.push_back((n1 - carry) + '0');
+            delete[] p;
+            return;
         }
-        else
+        free_blocks[size_class(n)].push_back(p);
+        cached += size;
+    }
+
+    // Frees cached blocks, largest first, until at most keep limbs are left
+    void trim(size_t keep)
+    {
+        for (size_t c = CLASSES; c-- > 0 && cached > keep;)
         {
-            if (carry)
-            {
-                result.push_back((n1 - carry) + '0');
-                carry = 0;
-            }
-            else
+            while (!free_blocks[c].empty() && cached > keep)
             {
-                result.push_back(n1 + '0');
+                delete[] free_blocks[c].back();
+                free_blocks[c].pop_back();
+                cached -= class_size(c);
             }
         }
     }
 
-    // reverse resultant string
-    reverse(result.begin(), result.end());
+    void set_limit(size_t limbs)
+    {
+        limit = limbs;
+        trim(limit);
+    }
+
+    size_t size() const { return cached; }
 
-    strip_leading_zeroes(result);
+private:
+    // Blocks are rounded up to 8 steps per power of two, so a temporary
+    // wastes at most an eighth of its block.
+    static const size_t CLASSES = 1 + 8 * 60;
 
-    return result;
+    static size_t block_size(size_t n) { return class_size(size_class(n)); }
+
+    static size_t size_class(size_t n)
+    {
+        if (n <= 16)
+            return 0;
+        size_t bits = 64 - __builtin_clzll(n - 1); // 2^(bits-1) < n <= 2^bits
+        size_t step = size_t(1) << (bits - 4);
+        return 8 * (bits - 5) + (n + step - 1) / step - 8;
+    }
+
+    static size_t class_size(size_t c)
+    {
+        if (c == 0)
+            return 16;
+        size_t bits = (c - 1) / 8 + 5;
+        return ((c - 1) % 8 + 9) << (bits - 4);
+    }
+
+    std::vector<limb_t *> free_blocks[CLASSES];
+    size_t cached; // limbs in free_blocks
+    size_t limit;  // most limbs kept in free_blocks
+};
+
+inline ScratchPool &scratch_pool()
+{
+    static thread_local ScratchPool pool;
+    return pool;
 }
 
+// Makes the scratch pool the current allocator until the end of the scope
+class ScratchScope : public BigIntAllocatorScope
+{
+public:
+    ScratchScope() : BigIntAllocatorScope(scratch_pool()) {}
+};
+
 /*
-    Multiplication
-    --------------
-    string = string * string
+    scratch_limbs
+    -------------
+    A zero filled temporary of n limbs from the scratch pool, for code that
+    can't put a ScratchScope around everything it allocates.
 */
 
-std::string multiplication(std::string s1, std::string s2)
+Limbs scratch_limbs(size_t n)
 {
-    /**
-     * Complexity of addition function
-     * 
-     * Time complexity : O(n2)
-     * Space complexity: O(n)
-     * 
-     * Algorithm of addition function
-     *      1. Input two string
-     *      2. Calculate length of two string
-     *      3. Multiplication by s1 all element with s2 all element
-     *      4. resultant string will be reverse
-     *      5. Zero insert will be every line after multiplication by increasing 1, except first element multiplication
-     *      6. Extra Zero remove from num2 head
-     *      7. Addition function will be call with parameter num1 and num2
-     *      8. Addition result will be store num1 and this processing will be continue until loop break
-     *      9. Return the final result string
-     */
+    ScratchScope scratch;
+    return Limbs(n);
+}
 
-    // Calculate length of both string
-    int len1 = s1.length();
-    int len2 = s2.length();
+/*
+    with_scratch
+    ------------
+    Calls f(t) with t[0..n) of scratch space, which is on the stack when n
+    is small, so that operations on small numbers don't go to the pool.
+*/
 
-    // Take two empty string for storing result
-    std::string num1 = "0";
-    std::string num2;
+template <class F>
+void with_scratch(size_t n, F f)
+{
+    limb_t local[64];
+    if (n <= 64)
+    {
+        f(local);
+        return;
+    }
+    Limbs t = scratch_limbs(n);
+    f(t.data());
+}
 
-    // Initially take carry zero
-    int carry = 0;
-    int n1, sum;
-    // zeroAdd
-    int zeroAdd = 0;
+/*
+    set_bigint_scratch_limit, trim_bigint_scratch, bigint_scratch_size
+    -------------------------------------------------------------------
+    Control the scratch pool of the calling thread. The limit is the most
+    limbs the pool keeps between uses (unlimited by default); a temporary
+    that doesn't fit is freed instead. trim_bigint_scratch frees everything
+    the pool holds, and bigint_scratch_size reports how much that is.
+*/
 
-    for (int i = len1 - 1; i >= 0; i--)
-    {
-        n1 = (s1[i] - '0');
-        if (n1 == 0)
-        {
-            zeroAdd++;
-            continue;
-        }
-        for (int j = len2 - 1; j >= 0; j--)
-        {
-            sum = n1 * (s2[j] - '0') + carry;
-            num2.push_back(sum % 10 + '0');
-            carry = sum / 10;
-        }
-        if (carry)
-        {
-            num2.push_back(carry + '0');
-            carry = 0;
-        }
+void set_bigint_scratch_limit(size_t limbs)
+{
+    scratch_pool().set_limit(limbs);
+}
 
-        reverse(num2.begin(), num2.end());
+void trim_bigint_scratch()
+{
+    scratch_pool().trim(0);
+}
 
-        if (1 <= zeroAdd)
-        {
-            for (int i = 1; i <= zeroAdd; i++) // Can be use library function for this operation?
-            {
-                num2.push_back('0');
-            }
-        }
+size_t bigint_scratch_size()
+{
+    return scratch_pool().size();
+}
 
-        // zero remove from head
-        strip_leading_zeroes(num2);
 
-        num1 = addition(num1, num2);
-        num2.clear();
-        zeroAdd++;
-    }
+/*
+    ===========================================================================
+    Multiplication
+    ===========================================================================
+    mul() picks the algorithm from the size of the smaller operand. The
+    thresholds are in limbs and can be tuned for the target machine.
+*/
+
+size_t KARATSUBA_THRESHOLD = 32;
+size_t TOOM3_THRESHOLD = 192;
+size_t TOOM4_THRESHOLD = 576;
+size_t FFT_THRESHOLD = 2048;
+
+void mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+void sqr(limb_t *r, const limb_t *a, size_t n);
+
+/*
+    mul_basecase
+    ------------
+    r[0..an+bn) = a[0..an) * b[0..bn). r must not alias a or b.
+*/
 
-    return num1;
+void mul_basecase(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    r[an] = mul_1(r, a, an, b[0]);
+    for (size_t j = 1; j < bn; j++)
+        r[an + j] = addmul_1(r + j, a, an, b[j]);
 }
 
 /*
-    Division
-    --------
-    string = string / string
+    sqr_basecase
+    ------------
+    r[0..2n) = a[0..n)^2. r must not alias a.
 */
 
-std::string division(std::string s1, std::string s2)
+void sqr_basecase(limb_t *r, const limb_t *a, size_t n)
 {
     /**
-     * Complexity of addition function
-     * 
-     * Time complexity : O(n2)
-     * Space complexity: O(n)
-     * 
-     * Algorithm of addition function
-     *      1. Input two string
-     *      2. Calculate length of two string
-     *      3. Multiplication by s1 all element with s2 all element
-     *      4. resultant string will be reverse
-     *      5. Zero insert will be every line after multiplication by increasing 1, except first element multiplication
-     *      6. Extra Zero remove from num2 head
-     *      7. Addition function will be call with parameter num1 and num2
-     *      8. Addition result will be store num1 and this processing will be continue until loop break
-     *      9. Return the final result string
+     * Algorithm of sqr_basecase function
+     *      1. Sum the products a[i]*a[j] with i < j, each one only once,
+     *         which is about half the work of mul_basecase
+     *      2. Double the sum with a one bit shift
+     *      3. Add the squares a[i]^2 on the diagonal
      */
 
-    if (s2 == "0")
-    {
-        std::cout << "Can't divided by zero" <<std:: endl;
-        exit(1);
-    }
-    else if (s1 == "0")
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if (n > 1)
     {
-        return "0";
+        r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+        for (size_t i = 1; i + 1 < n; i++)
+            r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
     }
 
-    int val = string_compare(s1, s2);
-
-    if (val == -1)
-        return "0";
-    else if (val == 0)
-        return "1";
-
-    std::string result;
+    lshift(r, r, 2 * n, 1);
 
-    for (int i = 0; i < s1.length(); i++)
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++)
     {
-        result += '0';
+        dlimb_t square = (dlimb_t)a[i] * a[i];
+        dlimb_t sum = (dlimb_t)r[2 * i] + (limb_t)square + carry;
+        r[2 * i] = (limb_t)sum;
+        sum = (sum >> 64) + r[2 * i + 1] + (limb_t)(square >> 64);
+        r[2 * i + 1] = (limb_t)sum;
+        carry = (limb_t)(sum >> 64);
     }
+}
 
-    std::string divisible;
+/*
+    sub_abs
+    -------
+    r[0..xn) = |x[0..xn) - y[0..yn)| with xn >= yn, returns true when x < y.
+*/
 
-    for (int i = 0; i < s1.length(); i++)
+bool sub_abs(limb_t *r, const limb_t *x, size_t xn, const limb_t *y, size_t yn)
+{
+    bool x_larger = false;
+    for (size_t i = yn; i < xn; i++)
     {
-        divisible += s1[i];
-        strip_leading_zeroes(divisible);
-
-        val = string_compare(divisible, s2);
-        while (val >= 0)
+        if (x[i])
         {
-            divisible = subtraction(divisible, s2);
-            result[i]++;
-            val = string_compare(divisible, s2);
+            x_larger = true;
+            break;
         }
     }
 
-    strip_leading_zeroes(result);
+    if (x_larger || cmp_n(x, y, yn) >= 0)
+    {
+        sub(r, x, xn, y, yn);
+        return false;
+    }
 
-    return result;
+    // y > x, so x has no limbs above yn
+    sub_n(r, y, x, yn);
+    std::fill(r + yn, r + xn, 0);
+    return true;
 }
 
 /*
-    Remainder
-    --------
-    string = string % string
+    mul_karatsuba
+    -------------
+    r[0..an+bn) = a[0..an) * b[0..bn), where an >= bn > h = ceil(an / 2).
 */
 
-std::string remainder(std::string s1, std::string s2)
+void mul_karatsuba(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
 {
     /**
-     * Complexity of addition function
-     * 
-     * Time complexity : O(n2)
+     * Complexity of mul_karatsuba function
+     *
+     * Time complexity : O(n^1.585)
      * Space complexity: O(n)
-     * 
-     * Algorithm of addition function
-     *      1. Input two string
-     *      2. Calculate length of two string
-     *      3. Multiplication by s1 all element with s2 all element
-     *      4. resultant string will be reverse
-     *      5. Zero insert will be every line after multiplication by increasing 1, except first element multiplication
-     *      6. Extra Zero remove from num2 head
-     *      7. Addition function will be call with parameter num1 and num2
-     *      8. Addition result will be store num1 and this processing will be continue until loop break
-     *      9. Return the final result string
+     *
+     * Algorithm of mul_karatsuba function
+     *      1. Split a = a0 + a1*B^h and b = b0 + b1*B^h
+     *      2. z0 = a0*b0 and z2 = a1*b1 go straight into the result
+     *      3. z1 = a0*b1 + a1*b0 = z0 + z2 - (a0 - a1)*(b0 - b1), which
+     *         costs one more half size product instead of two
+     *      4. Add z1 into the result at limb h
      */
 
-    if (s2 == "0")
+    size_t h = (an + 1) / 2;
+    const limb_t *a0 = a, *a1 = a + h;
+    const limb_t *b0 = b, *b1 = b + h;
+    size_t a1n = an - h, b1n = bn - h;
+
+    mul(r, a0, h, b0, h);
+    mul(r + 2 * h, a1, a1n, b1, b1n);
+
+    Limbs da(h), db(h), product(2 * h), middle(2 * h + 1);
+    bool negative = sub_abs(da.data(), a0, h, a1, a1n) != sub_abs(db.data(), b0, h, b1, b1n);
+    mul(product.data(), da.data(), h, db.data(), h);
+
+    // middle = z0 + z2 -/+ |(a0 - a1)*(b0 - b1)|
+    std::copy(r, r + 2 * h, middle.data());
+    middle[2 * h] = add(middle.data(), middle.data(), 2 * h, r + 2 * h, a1n + b1n);
+    if (negative)
+        add(middle.data(), middle.data(), 2 * h + 1, product.data(), 2 * h);
+    else
+        sub(middle.data(), middle.data(), 2 * h + 1, product.data(), 2 * h);
+
+    // the full product fits in an+bn limbs, so the top of middle that does
+    // not fit above limb h is zero
+    size_t mn = std::min(2 * h + 1, an + bn - h);
+    add(r + h, r + h, an + bn - h, middle.data(), mn);
+}
+
+/*
+    sqr_karatsuba
+    -------------
+    r[0..2n) = a[0..n)^2, the squaring form of mul_karatsuba. The middle
+    term is z0 + z2 - (a0 - a1)^2, which is never negative.
+*/
+
+void sqr_karatsuba(limb_t *r, const limb_t *a, size_t n)
+{
+    size_t h = (n + 1) / 2;
+    size_t a1n = n - h;
+
+    sqr(r, a, h);
+    sqr(r + 2 * h, a + h, a1n);
+
+    Limbs da(h), product(2 * h), middle(2 * h + 1);
+    sub_abs(da.data(), a, h, a + h, a1n);
+    sqr(product.data(), da.data(), h);
+
+    std::copy(r, r + 2 * h, middle.data());
+    middle[2 * h] = add(middle.data(), middle.data(), 2 * h, r + 2 * h, 2 * a1n);
+    sub(middle.data(), middle.data(), 2 * h + 1, product.data(), 2 * h);
+
+    size_t mn = std::min(2 * h + 1, 2 * n - h);
+    add(r + h, r + h, 2 * n - h, middle.data(), mn);
+}
+
+/*
+    SignedLimbs
+    -----------
+    A magnitude with a sign, for the Toom-Cook evaluation and interpolation
+    steps where intermediate values can go negative. Zero is never negative.
+*/
+
+struct SignedLimbs
+{
+    Limbs mag;
+    bool negative;
+
+    SignedLimbs() : negative(false) {}
+};
+
+SignedLimbs signed_from(const limb_t *a, size_t n)
+{
+    while (n > 0 && a[n - 1] == 0)
+        n--;
+
+    SignedLimbs x;
+    x.mag.resize(n);
+    std::copy(a, a + n, x.mag.data());
+    return x;
+}
+
+/*
+    signed_add
+    ----------
+    x = x + y, or x = x - y when subtract is set.
+*/
+
+void signed_add(SignedLimbs &x, const SignedLimbs &y, bool subtract = false)
+{
+    bool y_negative = y.negative != subtract;
+    size_t xn = x.mag.size(), yn = y.mag.size();
+
+    if (yn == 0)
+        return;
+
+    if (x.negative == y_negative || xn == 0)
     {
-        std::cout << "Can't divided by zero" << std::endl;
-        exit(1);
+        if (xn < yn)
+            x.mag.resize(yn);
+        limb_t carry = add(x.mag.data(), x.mag.data(), x.mag.size(), y.mag.data(), yn);
+        if (carry)
+            x.mag.push_back(carry);
+        x.negative = y_negative;
+        return;
     }
-    else if (s1 == "0")
+
+    int val = magnitude_compare(x.mag, y.mag);
+    if (val >= 0)
     {
-        return "0";
+        sub(x.mag.data(), x.mag.data(), xn, y.mag.data(), yn);
     }
+    else
+    {
+        x.mag.resize(yn);
+        sub(x.mag.data(), y.mag.data(), yn, x.mag.data(), xn);
+        x.negative = y_negative;
+    }
+
+    strip_leading_zeroes(x.mag);
+    if (x.mag.empty())
+        x.negative = false;
+}
 
-    int val = string_compare(s1, s2);
+/*
+    signed_mul_1
+    ------------
+    x = x * m for a small signed factor m.
+*/
 
-    if (val == -1)
-        return s1;
-    else if (val == 0)
-        return "0";
+void signed_mul_1(SignedLimbs &x, long m)
+{
+    if (x.mag.empty())
+        return;
 
-    std::string modValue;
+    limb_t carry = mul_1(x.mag.data(), x.mag.data(), x.mag.size(), m < 0 ? -m : m);
+    if (carry)
+        x.mag.push_back(carry);
+    if (m < 0)
+        x.negative = !x.negative;
+    strip_leading_zeroes(x.mag);
+    if (x.mag.empty())
+        x.negative = false;
+}
 
-    for (int i = 0; i < s1.length(); i++)
-    {
-        modValue += s1[i];
-        strip_leading_zeroes(modValue);
+/*
+    signed_divexact_1
+    -----------------
+    x = x / d, where d is known to divide x.
+*/
 
-        val = string_compare(modValue, s2);
-        while (val >= 0)
-        {
-            modValue = subtraction(modValue, s2);
-            val = string_compare(modValue, s2);
-        }
-    }
+void signed_divexact_1(SignedLimbs &x, limb_t d)
+{
+    divrem_1(x.mag.data(), x.mag.data(), x.mag.size(), d);
+    strip_leading_zeroes(x.mag);
+}
 
-    return modValue;
+/*
+    signed_mul
+    ----------
+    Pointwise product of two evaluations, through mul().
+*/
+
+SignedLimbs signed_mul(const SignedLimbs &x, const SignedLimbs &y)
+{
+    SignedLimbs product;
+    if (x.mag.empty() || y.mag.empty())
+        return product;
+
+    const Limbs &longer = x.mag.size() >= y.mag.size() ? x.mag : y.mag;
+    const Limbs &shorter = x.mag.size() >= y.mag.size() ? y.mag : x.mag;
+
+    // when x and y are the same object mul() sees equal operands and squares
+    product.mag.resize(longer.size() + shorter.size());
+    mul(product.mag.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
+    strip_leading_zeroes(product.mag);
+    product.negative = x.negative != y.negative;
+    return product;
 }
 
 /*
-    Access digit
-    ---------------
-    return specific digit by given index
+    toom_eval
+    ---------
+    Evaluate the polynomial whose coefficients are the k limb pieces of
+    a[0..n) at a small integer point, by Horner's rule. With reversed set
+    the coefficients are taken highest first, which gives 2^(pieces-1) *
+    p(1/2) for point 2. Point 0 gives the lowest piece, or the highest one
+    (the value at infinity) when reversed.
 */
 
-BigInt BigInt::operator[](int index)
+SignedLimbs toom_eval(const limb_t *a, size_t n, size_t k, int pieces, long point,
+                      bool reversed = false)
 {
-    if (this->bigInteger.length() <= index)
+    SignedLimbs value;
+    for (int j = 0; j < pieces; j++)
     {
-        std::cout << "Error: Index out of bounds" << std::endl;
-        exit(1);
+        int i = reversed ? j : pieces - 1 - j;
+        size_t start = std::min(n, i * k);
+        size_t len = std::min(k, n - start);
+
+        signed_mul_1(value, point);
+        signed_add(value, signed_from(a + start, len));
     }
+    return value;
+}
+
+/*
+    toom_point
+    ----------
+    The product a(x) * b(x) at one evaluation point. When a and b are the
+    same operand it is evaluated once and squared.
+*/
 
-    std::string s;
-    s += bigInteger[index];
-    return BigInt(s);
+SignedLimbs toom_point(const limb_t *a, size_t an, const limb_t *b, size_t bn, size_t k,
+                       int pieces, long point, bool reversed = false)
+{
+    SignedLimbs x = toom_eval(a, an, k, pieces, point, reversed);
+    if (a == b && an == bn)
+        return signed_mul(x, x);
+    return signed_mul(x, toom_eval(b, bn, k, pieces, point, reversed));
 }
 
 /*
-    Logical and
-    -----------
-    BigInt && BigInt
+    toom_recompose
+    --------------
+    r[0..rn) = sum of c[i] * B^(i*k). Every coefficient of a product of
+    non-negative polynomials is non-negative, and c[i] * B^(i*k) is at most
+    the full product, so each c[i] fits above its offset.
 */
 
-bool BigInt::operator&&(BigInt &obj)
+void toom_recompose(limb_t *r, size_t rn, size_t k, const SignedLimbs *c, int count)
 {
-    BigInt zero("0");
-    return (zero != *this) && (zero != obj);
+    std::fill(r, r + rn, 0);
+    for (int i = 0; i < count; i++)
+    {
+        if (!c[i].mag.empty())
+            add(r + i * k, r + i * k, rn - i * k, c[i].mag.data(), c[i].mag.size());
+    }
+}
+
+/*
+    mul_toom3
+    ---------
+    r[0..an+bn) = a[0..an) * b[0..bn), where an >= bn > ceil(an / 3).
+*/
+
+void mul_toom3(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    /**
+     * Complexity of mul_toom3 function
+     *
+     * Time complexity : O(n^1.465)
+     * Space complexity: O(n)
+     *
+     * Algorithm of mul_toom3 function
+     *      1. Split both operands into three k limb pieces, the coefficients
+     *         of two degree 2 polynomials a(x) and b(x) with x = B^k
+     *      2. Evaluate both at 0, 1, -1, -2 and infinity
+     *      3. Multiply the five pairs of values recursively
+     *      4. Interpolate the five coefficients of the product with Bodrato's
+     *         sequence, which only needs exact divisions by 2 and 3
+     *      5. Add the coefficients together at their limb offsets
+     */
+
+    size_t k = (an + 2) / 3;
+
+    SignedLimbs r0 = toom_point(a, an, b, bn, k, 3, 0);
+    SignedLimbs r1 = toom_point(a, an, b, bn, k, 3, 1);
+    SignedLimbs rm1 = toom_point(a, an, b, bn, k, 3, -1);
+    SignedLimbs rm2 = toom_point(a, an, b, bn, k, 3, -2);
+    SignedLimbs rinf = toom_point(a, an, b, bn, k, 3, 0, true);
+
+    // r3 = (r(-2) - r(1)) / 3
+    SignedLimbs r3 = rm2;
+    signed_add(r3, r1, true);
+    signed_divexact_1(r3, 3);
+
+    // r1 = (r(1) - r(-1)) / 2
+    signed_add(r1, rm1, true);
+    signed_divexact_1(r1, 2);
+
+    // r2 = r(-1) - r(0)
+    SignedLimbs r2 = rm1;
+    signed_add(r2, r0, true);
+
+    // r3 = (r2 - r3) / 2 + 2 * r(inf)
+    SignedLimbs half = r2;
+    signed_add(half, r3, true);
+    signed_divexact_1(half, 2);
+    r3 = half;
+    signed_add(r3, rinf);
+    signed_add(r3, rinf);
+
+    // r2 = r2 + r1 - r(inf)
+    signed_add(r2, r1);
+    signed_add(r2, rinf, true);
+
+    // r1 = r1 - r3
+    signed_add(r1, r3, true);
+
+    SignedLimbs c[5] = {r0, r1, r2, r3, rinf};
+    toom_recompose(r, an + bn, k, c, 5);
+}
+
+/*
+    mul_toom4
+    ---------
+    r[0..an+bn) = a[0..an) * b[0..bn), where an >= bn > ceil(an / 4).
+*/
+
+void mul_toom4(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    /**
+     * Complexity of mul_toom4 function
+     *
+     * Time complexity : O(n^1.404)
+     * Space complexity: O(n)
+     *
+     * Algorithm of mul_toom4 function
+     *      1. Split both operands into four k limb pieces, the coefficients
+     *         of two degree 3 polynomials a(x) and b(x) with x = B^k
+     *      2. Evaluate both at 0, 1, -1, 2, -2, 1/2 and infinity
+     *      3. Multiply the seven pairs of values recursively
+     *      4. Interpolate: the even and odd parts of the values at +-1 and
+     *         +-2 give c2, c4 directly, and together with the value at 1/2
+     *         give c1, c3, c5. Only exact divisions by 2, 3, 4 and 5 occur
+     *      5. Add the coefficients together at their limb offsets
+     */
+
+    size_t k = (an + 3) / 4;
+
+    SignedLimbs c0 = toom_point(a, an, b, bn, k, 4, 0);
+    SignedLimbs r1 = toom_point(a, an, b, bn, k, 4, 1);
+    SignedLimbs rm1 = toom_point(a, an, b, bn, k, 4, -1);
+    SignedLimbs r2 = toom_point(a, an, b, bn, k, 4, 2);
+    SignedLimbs rm2 = toom_point(a, an, b, bn, k, 4, -2);
+    SignedLimbs rh = toom_point(a, an, b, bn, k, 4, 2, true);
+    SignedLimbs c6 = toom_point(a, an, b, bn, k, 4, 0, true);
+
+    // even part at 1: e1 = c2 + c4 and odd part o1 = c1 + c3 + c5
+    SignedLimbs e1 = r1;
+    signed_add(e1, rm1);
+    signed_divexact_1(e1, 2);
+    signed_add(e1, c0, true);
+    signed_add(e1, c6, true);
+    SignedLimbs o1 = r1;
+    signed_add(o1, rm1, true);
+    signed_divexact_1(o1, 2);
+
+    // even part at 2: e2 = c2 + 4*c4 and odd part o2 = c1 + 4*c3 + 16*c5
+    SignedLimbs e2 = r2;
+    signed_add(e2, rm2);
+    signed_divexact_1(e2, 2);
+    signed_add(e2, c0, true);
+    SignedLimbs scaled = c6;
+    signed_mul_1(scaled, 64);
+    signed_add(e2, scaled, true);
+    signed_divexact_1(e2, 4);
+    SignedLimbs o2 = r2;
+    signed_add(o2, rm2, true);
+    signed_divexact_1(o2, 4);
+
+    // c4 = (e2 - e1) / 3, c2 = e1 - c4
+    SignedLimbs c4 = e2;
+    signed_add(c4, e1, true);
+    signed_divexact_1(c4, 3);
+    SignedLimbs c2 = e1;
+    signed_add(c2, c4, true);
+
+    // h = (64*r(1/2) - 64*c0 - 16*c2 - 4*c4 - c6) / 2 = 16*c1 + 4*c3 + c5
+    SignedLimbs h = rh;
+    scaled = c0;
+    signed_mul_1(scaled, 64);
+    signed_add(h, scaled, true);
+    scaled = c2;
+    signed_mul_1(scaled, 16);
+    signed_add(h, scaled, true);
+    scaled = c4;
+    signed_mul_1(scaled, 4);
+    signed_add(h, scaled, true);
+    signed_add(h, c6, true);
+    signed_divexact_1(h, 2);
+
+    // t = (o2 - o1) / 3 = c3 + 5*c5, u = (16*o1 - h) / 3 = 4*c3 + 5*c5
+    SignedLimbs t = o2;
+    signed_add(t, o1, true);
+    signed_divexact_1(t, 3);
+    SignedLimbs u = o1;
+    signed_mul_1(u, 16);
+    signed_add(u, h, true);
+    signed_divexact_1(u, 3);
+
+    // c3 = (u - t) / 3, c5 = (t - c3) / 5, c1 = o1 - c3 - c5
+    SignedLimbs c3 = u;
+    signed_add(c3, t, true);
+    signed_divexact_1(c3, 3);
+    SignedLimbs c5 = t;
+    signed_add(c5, c3, true);
+    signed_divexact_1(c5, 5);
+    SignedLimbs c1 = o1;
+    signed_add(c1, c3, true);
+    signed_add(c1, c5, true);
+
+    SignedLimbs c[7] = {c0, c1, c2, c3, c4, c5, c6};
+    toom_recompose(r, an + bn, k, c, 7);
+}
+
+/*
+    NttPrime
+    --------
+    Arithmetic modulo one of the primes c * 2^50 + 1 used by the number
+    theoretic transform. Values are kept in Montgomery form, x * 2^64 mod p,
+    so that a modular product is two multiplications and no division.
+*/
+
+struct NttPrime
+{
+    limb_t p;     // the prime
+    limb_t p_inv; // -p^-1 mod 2^64
+    limb_t r2;    // 2^128 mod p
+    limb_t root;  // primitive root, in Montgomery form
+    limb_t one;   // 1 in Montgomery form
+
+    NttPrime(limb_t prime, limb_t generator) : p(prime)
+    {
+        // Newton iteration for p^-1 mod 2^64, each step doubles the bits
+        limb_t inv = prime;
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - prime * inv;
+        p_inv = 0 - inv;
+
+        limb_t r1 = (limb_t)(((dlimb_t)1 << 64) % prime);
+        r2 = (limb_t)((dlimb_t)r1 * r1 % prime);
+        one = r1;
+        root = to_mont(generator);
+    }
+
+    // t * 2^-64 mod p, for t < p * 2^64
+    limb_t reduce(dlimb_t t) const
+    {
+        limb_t m = (limb_t)t * p_inv;
+        limb_t result = (limb_t)((t + (dlimb_t)m * p) >> 64);
+        return result >= p ? result - p : result;
+    }
+
+    limb_t mul(limb_t a, limb_t b) const { return reduce((dlimb_t)a * b); }
+    limb_t add(limb_t a, limb_t b) const { limb_t s = a + b; return s >= p ? s - p : s; }
+    limb_t sub(limb_t a, limb_t b) const { return a - b + (p & (0 - (limb_t)(a < b))); }
+    limb_t to_mont(limb_t a) const { return mul(a % p, r2); }
+
+    limb_t pow(limb_t base, limb_t exponent) const
+    {
+        limb_t result = one;
+        for (; exponent; exponent >>= 1)
+        {
+            if (exponent & 1)
+                result = mul(result, base);
+            base = mul(base, base);
+        }
+        return result;
+    }
+};
+
+const NttPrime NTT_PRIMES[3] = {
+    NttPrime(4601552919265804289ULL, 3),  // 4087 * 2^50 + 1
+    NttPrime(4546383823830515713ULL, 10), // 4038 * 2^50 + 1
+    NttPrime(4522739925786820609ULL, 37), // 4017 * 2^50 + 1
+};
+
+/*
+    ntt
+    ---
+    In place radix-2 transform of a[0..n), n a power of two, over one NTT
+    prime. The inverse transform leaves every value multiplied by n.
+*/
+
+void ntt(limb_t *a, size_t n, const NttPrime &P, bool inverse)
+{
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+
+    Limbs twiddle(n / 2);
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        size_t half = len / 2;
+        limb_t step = P.pow(P.root, (P.p - 1) / len);
+        if (inverse)
+            step = P.pow(step, P.p - 2);
+
+        limb_t *w = twiddle.data();
+        w[0] = P.one;
+        for (size_t j = 1; j < half; j++)
+            w[j] = P.mul(w[j - 1], step);
+
+        for (size_t i = 0; i < n; i += len)
+        {
+            limb_t *lo = a + i, *hi = a + i + half;
+            for (size_t j = 0; j < half; j++)
+            {
+                limb_t u = lo[j];
+                limb_t v = P.mul(hi[j], w[j]);
+                lo[j] = P.add(u, v);
+                hi[j] = P.sub(u, v);
+            }
+        }
+    }
+}
+
+/*
+    mul_fft
+    -------
+    r[0..an+bn) = a[0..an) * b[0..bn), where an >= bn >= 1.
+*/
+
+void mul_fft(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    /**
+     * Complexity of mul_fft function
+     *
+     * Time complexity : O(n log n)
+     * Space complexity: O(n)
+     *
+     * Algorithm of mul_fft function
+     *      1. Treat the limbs as polynomial coefficients. Each coefficient of
+     *         the product is below bn * 2^128 < 2^178, so it is determined by
+     *         its residues modulo three 62-bit primes
+     *      2. For each prime, transform both operands, multiply pointwise
+     *         and transform back, giving the cyclic convolution mod p. A
+     *         square transforms its operand once
+     *      3. Rebuild every coefficient from its three residues (Garner's
+     *         CRT) and add it into the result with carry propagation
+     */
+
+    const NttPrime &P1 = NTT_PRIMES[0], &P2 = NTT_PRIMES[1], &P3 = NTT_PRIMES[2];
+
+    size_t rn = an + bn;
+    size_t n = 1;
+    while (n < rn - 1)
+        n <<= 1;
+
+    // a square needs only one forward transform per prime
+    bool square = (a == b && an == bn);
+    Limbs residues[3], transform(square ? 0 : n);
+    for (int k = 0; k < 3; k++)
+    {
+        const NttPrime &P = NTT_PRIMES[k];
+        residues[k].resize(n);
+        limb_t *fa = residues[k].data(), *fb = transform.data();
+
+        for (size_t i = 0; i < an; i++)
+            fa[i] = P.to_mont(a[i]);
+        std::fill(fa + an, fa + n, 0);
+        ntt(fa, n, P, false);
+
+        if (square)
+        {
+            for (size_t i = 0; i < n; i++)
+                fa[i] = P.mul(fa[i], fa[i]);
+        }
+        else
+        {
+            for (size_t i = 0; i < bn; i++)
+                fb[i] = P.to_mont(b[i]);
+            std::fill(fb + bn, fb + n, 0);
+            ntt(fb, n, P, false);
+
+            for (size_t i = 0; i < n; i++)
+                fa[i] = P.mul(fa[i], fb[i]);
+        }
+        ntt(fa, n, P, true);
+
+        // one reduction by n^-1 both undoes the factor n and leaves
+        // Montgomery form
+        limb_t n_inv = P.mul(P.pow(P.to_mont(n), P.p - 2), 1);
+        for (size_t i = 0; i < rn - 1; i++)
+            fa[i] = P.mul(fa[i], n_inv);
+    }
+
+    const limb_t *x1 = residues[0].data(), *x2 = residues[1].data(), *x3 = residues[2].data();
+
+    // Garner constants, in Montgomery form so that P.mul() of a plain value
+    // by one of them gives a plain product
+    limb_t p1_inv_2 = P2.pow(P2.to_mont(P1.p), P2.p - 2);
+    limb_t p1_3 = P3.to_mont(P1.p);
+    limb_t p1p2_inv_3 = P3.pow(P3.mul(P3.to_mont(P1.p), P3.to_mont(P2.p)), P3.p - 2);
+    dlimb_t p1p2 = (dlimb_t)P1.p * P2.p;
+
+    limb_t carry[3] = {0, 0, 0};
+    for (size_t i = 0; i < rn; i++)
+    {
+        limb_t x[3] = {0, 0, 0};
+        if (i < rn - 1)
+        {
+            // x = v1 + p1*v2 + p1*p2*v3
+            limb_t v1 = x1[i];
+            limb_t v2 = P2.mul(P2.sub(x2[i], v1 % P2.p), p1_inv_2);
+            limb_t v3 = P3.sub(P3.sub(x3[i], v1 % P3.p), P3.mul(v2, p1_3));
+            v3 = P3.mul(v3, p1p2_inv_3);
+
+            dlimb_t low = (dlimb_t)P1.p * v2 + v1;
+            dlimb_t part = (dlimb_t)(limb_t)p1p2 * v3;
+            dlimb_t high = (dlimb_t)(limb_t)(p1p2 >> 64) * v3;
+
+            dlimb_t sum = (dlimb_t)(limb_t)low + (limb_t)part;
+            x[0] = (limb_t)sum;
+            sum = (sum >> 64) + (limb_t)(low >> 64) + (limb_t)(part >> 64) + (limb_t)high;
+            x[1] = (limb_t)sum;
+            x[2] = (limb_t)(sum >> 64) + (limb_t)(high >> 64);
+        }
+
+        // add the coefficient and the carry from the limbs below
+        dlimb_t sum = (dlimb_t)x[0] + carry[0];
+        r[i] = (limb_t)sum;
+        sum = (sum >> 64) + x[1] + carry[1];
+        carry[0] = (limb_t)sum;
+        sum = (sum >> 64) + x[2] + carry[2];
+        carry[1] = (limb_t)sum;
+        carry[2] = (limb_t)(sum >> 64);
+    }
+}
+
+/*
+    mul
+    ---
+    r[0..an+bn) = a[0..an) * b[0..bn), where an >= bn >= 1. r must not
+    alias a or b.
+*/
+
+void mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn)
+{
+    if (a == b && an == bn)
+    {
+        sqr(r, a, an);
+        return;
+    }
+
+    // one limb cannot be halved, and the Toom points of two limbs are two
+    // limbs again, so those sizes stay on the lower tiers whatever the
+    // thresholds say
+    if (bn < KARATSUBA_THRESHOLD || bn < 2)
+    {
+        mul_basecase(r, a, an, b, bn);
+        return;
+    }
+
+    ScratchScope scratch;
+
+    if (bn >= FFT_THRESHOLD)
+    {
+        mul_fft(r, a, an, b, bn);
+        return;
+    }
+
+    if (bn > (an + 1) / 2)
+    {
+        if (bn < TOOM3_THRESHOLD || bn < 3)
+            mul_karatsuba(r, a, an, b, bn);
+        else if (bn < TOOM4_THRESHOLD)
+            mul_toom3(r, a, an, b, bn);
+        else
+            mul_toom4(r, a, an, b, bn);
+        return;
+    }
+
+    // Unbalanced operands: multiply b by bn limb pieces of a and add the
+    // partial products in at their offsets.
+    mul(r, a, bn, b, bn);
+
+    Limbs product(2 * bn);
+    for (size_t i = bn; i < an; i += bn)
+    {
+        size_t cn = std::min(bn, an - i);
+        mul(product.data(), b, bn, a + i, cn);
+
+        limb_t carry = add_n(r + i, r + i, product.data(), bn);
+        std::copy(product.data() + bn, product.data() + bn + cn, r + i + bn);
+        add_1(r + i + bn, r + i + bn, cn, carry);
+    }
+}
+
+/*
+    sqr
+    ---
+    r[0..2n) = a[0..n)^2, where n >= 1. r must not alias a. Uses the same
+    thresholds as mul(); every tier saves work on a square.
+*/
+
+void sqr(limb_t *r, const limb_t *a, size_t n)
+{
+    if (n < KARATSUBA_THRESHOLD || n < 2)
+    {
+        sqr_basecase(r, a, n);
+        return;
+    }
+
+    ScratchScope scratch;
+
+    if (n < TOOM3_THRESHOLD || n < 3)
+        sqr_karatsuba(r, a, n);
+    else if (n < TOOM4_THRESHOLD)
+        mul_toom3(r, a, n, a, n);
+    else if (n < FFT_THRESHOLD)
+        mul_toom4(r, a, n, a, n);
+    else
+        mul_fft(r, a, n, a, n);
+}
+
+/*
+    ===========================================================================
+    Division
+    ===========================================================================
+    All the division kernels work on a normalized divisor v (top bit of
+    v[vn-1] set). They divide u[0..un) in place, writing un-vn quotient
+    limbs to q and returning the quotient's extra top limb qh (0 or 1). The
+    remainder is left in u[0..vn). DC_DIV_THRESHOLD is in limbs and can be
+    tuned like the multiplication thresholds.
+*/
+
+size_t DC_DIV_THRESHOLD = 48;
+
+/*
+    div_basecase
+    ------------
+    Knuth's Algorithm D.
+*/
+
+constexpr limb_t div_basecase(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn)
+{
+    /**
+     * Complexity of div_basecase function
+     *
+     * Time complexity : O((un-vn)*vn)
+     * Space complexity: O(1)
+     *
+     * Algorithm of div_basecase function
+     *      1. If the top vn limbs of u are not below v, subtract v there and
+     *         return qh = 1, so that every later quotient limb fits
+     *      2. For each quotient limb, from the top, estimate it from the top
+     *         two limbs of the running remainder and the top limb of v
+     *      3. Correct the estimate with the second limb of v; because v is
+     *         normalized it is now at most one too large
+     *      4. Subtract estimate * v in one multiply-subtract pass, and add v
+     *         back in the rare case that went negative
+     */
+
+    size_t m = un - vn;
+    limb_t qh = cmp_n(u + m, v, vn) >= 0;
+    if (qh)
+        sub_n(u + m, u + m, v, vn);
+
+    if (vn == 1)
+    {
+        limb_t rem = u[m];
+        for (size_t j = m; j-- > 0;)
+        {
+            dlimb_t numerator = ((dlimb_t)rem << 64) | u[j];
+            q[j] = (limb_t)(numerator / v[0]);
+            rem = (limb_t)(numerator % v[0]);
+        }
+        u[0] = rem;
+        return qh;
+    }
+
+    limb_t v1 = v[vn - 1], v2 = v[vn - 2];
+
+    for (size_t j = m; j-- > 0;)
+    {
+        dlimb_t numerator = ((dlimb_t)u[j + vn] << 64) | u[j + vn - 1];
+        dlimb_t qhat = numerator / v1;
+        dlimb_t rhat = numerator % v1;
+
+        while ((qhat >> 64) || qhat * v2 > ((rhat << 64) | u[j + vn - 2]))
+        {
+            qhat--;
+            rhat += v1;
+            if (rhat >> 64)
+                break;
+        }
+
+        limb_t borrow = submul_1(u + j, v, vn, (limb_t)qhat);
+        limb_t top = u[j + vn];
+        u[j + vn] = top - borrow;
+
+        if (top < borrow)
+        {
+            qhat--;
+            u[j + vn] += add_n(u + j, u + j, v, vn);
+        }
+
+        q[j] = (limb_t)qhat;
+    }
+
+    return qh;
+}
+
+limb_t div_dc_n(limb_t *q, limb_t *u, const limb_t *v, size_t n);
+
+/*
+    div_dc_half
+    -----------
+    One half step of the recursive division: divides u[0..n+m) by v[0..n)
+    with m <= n quotient limbs. The quotient is first estimated from the top
+    2m limbs of u and the top m limbs of v, recursively, and then corrected
+    by subtracting estimate * (low n-m limbs of v) with the fast multiplier.
+*/
+
+limb_t div_dc_half(limb_t *q, limb_t *u, const limb_t *v, size_t n, size_t m)
+{
+    limb_t qh;
+    if (m < DC_DIV_THRESHOLD || m < 2)
+        qh = div_basecase(q, u + n - m, 2 * m, v + n - m, m);
+    else
+        qh = div_dc_n(q, u + n - m, v + n - m, m);
+
+    if (m == n)
+        return qh;
+
+    // u[0..n) -= q * v[0..n-m), with qh * v[0..n-m) at limb m on top
+    size_t low = n - m;
+    Limbs product(n);
+    if (low >= m)
+        mul(product.data(), v, low, q, m);
+    else
+        mul(product.data(), q, m, v, low);
+
+    limb_t borrow = sub_n(u, u, product.data(), n);
+    if (qh)
+        borrow += sub_n(u + m, u + m, v, low);
+
+    // the estimate is at most two too large
+    while (borrow)
+    {
+        qh -= sub_1(q, q, m, 1);
+        borrow -= add_n(u, u, v, n);
+    }
+
+    return qh;
+}
+
+/*
+    div_dc_n
+    --------
+    Divides u[0..2n) by v[0..n), giving n quotient limbs.
+*/
+
+limb_t div_dc_n(limb_t *q, limb_t *u, const limb_t *v, size_t n)
+{
+    /**
+     * Complexity of div_dc_n function
+     *
+     * Time complexity : O(M(n) log n), where M(n) is the cost of mul()
+     * Space complexity: O(n)
+     *
+     * Algorithm of div_dc_n function (Burnikel-Ziegler)
+     *      1. Split the quotient into a high half of hi limbs and a low
+     *         half of lo limbs
+     *      2. Get the high half from the top 2*hi limbs of u and the top hi
+     *         limbs of v, then correct it against the rest of v
+     *      3. Get the low half in the same way from what remains
+     */
+
+    size_t lo = n / 2, hi = n - lo;
+
+    limb_t qh = div_dc_half(q + lo, u + lo, v, n, hi);
+    div_dc_half(q, u, v, n, lo);
+
+    return qh;
+}
+
+/*
+    div_dc
+    ------
+    Divide and conquer division for any un >= vn.
+*/
+
+limb_t div_dc(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn)
+{
+    size_t m = un - vn;
+    limb_t qh = cmp_n(u + m, v, vn) >= 0;
+    if (qh)
+        sub_n(u + m, u + m, v, vn);
+
+    // Every block below sees a remainder smaller than v on top, so none of
+    // them has a quotient limb of its own to return.
+
+    // quotient limbs that do not fill a whole block of vn come first
+    size_t partial = m % vn;
+    if (partial)
+    {
+        m -= partial;
+        div_dc_half(q + m, u + m, v, vn, partial);
+    }
+
+    while (m > 0)
+    {
+        m -= vn;
+        div_dc_n(q + m, u + m, v, vn);
+    }
+
+    return qh;
+}
+
+/*
+    divrem
+    ------
+    q[0..an-dn+1) = a[0..an) / d[0..dn) and r[0..dn) = a % d, where
+    an >= dn >= 1 and d[dn-1] != 0. Either q or r may be null when only the
+    other result is wanted.
+*/
+
+void divrem(limb_t *q, limb_t *r, const limb_t *a, size_t an, const limb_t *d, size_t dn)
+{
+    ScratchScope scratch;
+    Limbs quotient(q ? 0 : an - dn + 1);
+    if (!q)
+        q = quotient.data();
+
+    if (dn == 1)
+    {
+        limb_t rem = divrem_1(q, a, an, d[0]);
+        if (r)
+            r[0] = rem;
+        return;
+    }
+
+    // Normalize so that the top bit of the divisor is set, with one extra
+    // limb on top of the dividend.
+    unsigned shift = __builtin_clzll(d[dn - 1]);
+    Limbs v(dn), u(an + 1);
+    if (shift)
+    {
+        lshift(v.data(), d, dn, shift);
+        u[an] = lshift(u.data(), a, an, shift);
+    }
+    else
+    {
+        std::copy(d, d + dn, v.data());
+        std::copy(a, a + an, u.data());
+        u[an] = 0;
+    }
+
+    // u[an] < v[dn-1], so qh is always zero here
+    if (dn < DC_DIV_THRESHOLD || an + 1 - dn < DC_DIV_THRESHOLD)
+        div_basecase(q, u.data(), an + 1, v.data(), dn);
+    else
+        div_dc(q, u.data(), an + 1, v.data(), dn);
+
+    if (r)
+    {
+        if (shift)
+            rshift(r, u.data(), dn, shift);
+        else
+            std::copy(u.data(), u.data() + dn, r);
+    }
+}
+
+
+/*
+    ===========================================================================
+    Modular arithmetic
+    ===========================================================================
+    Arithmetic modulo a fixed m[0..n) with m[n-1] != 0. Residues are kept
+    in exactly n limbs, so the top limbs of a residue may be zero.
+*/
+
+/*
+    Montgomery
+    ----------
+    Montgomery arithmetic modulo an odd m. A residue x is kept in the form
+    x * R mod m, where R = 2^(64n). The product of two such residues is
+    brought back below m by REDC, which divides by R with n single limb
+    multiply-adds instead of a long division.
+*/
+
+struct Montgomery
+{
+    Limbs m;             // the modulus
+    size_t n;
+    limb_t m_inv;        // -m^-1 mod 2^64
+    Limbs r2;            // R^2 mod m
+    size_t scratch_size; // limbs of scratch space t that the operations need
+
+    Montgomery() : n(0), m_inv(0), scratch_size(0) {}
+
+    Montgomery(const limb_t *modulus, size_t size)
+        : m(size), n(size), r2(size), scratch_size(2 * size)
+    {
+        std::copy(modulus, modulus + n, m.data());
+
+        // Newton iteration for m^-1 mod 2^64, each step doubles the bits
+        limb_t inv = m[0];
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - m[0] * inv;
+        m_inv = 0 - inv;
+
+        Limbs power(2 * n + 1);
+        power[2 * n] = 1;
+        divrem(nullptr, r2.data(), power.data(), 2 * n + 1, m.data(), n);
+    }
+
+    // r = t / R mod m, for t[0..2n) < m * R. t is overwritten.
+    void redc(limb_t *r, limb_t *t) const
+    {
+        limb_t high = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            limb_t carry = addmul_1(t + i, m.data(), n, t[i] * m_inv);
+            dlimb_t top = (dlimb_t)t[i + n] + carry + high;
+            t[i + n] = (limb_t)top;
+            high = (limb_t)(top >> 64);
+        }
+        // t / R < 2m, so one subtraction is enough
+        if (high || cmp_n(t + n, m.data(), n) >= 0)
+            sub_n(r, t + n, m.data(), n);
+        else
+            std::copy(t + n, t + 2 * n, r);
+    }
+
+    // r = a * b / R mod m, with t[0..2n) as scratch. r may alias a or b.
+    void mul(limb_t *r, const limb_t *a, const limb_t *b, limb_t *t) const
+    {
+        ::mul(t, a, n, b, n);
+        redc(r, t);
+    }
+
+    void sqr(limb_t *r, const limb_t *a, limb_t *t) const
+    {
+        ::sqr(t, a, n);
+        redc(r, t);
+    }
+
+    // Into and out of Montgomery form, for a < m
+    void to_form(limb_t *r, const limb_t *a, limb_t *t) const { mul(r, a, r2.data(), t); }
+
+    void from_form(limb_t *r, const limb_t *a, limb_t *t) const
+    {
+        std::copy(a, a + n, t);
+        std::fill(t + n, t + 2 * n, 0);
+        redc(r, t);
+    }
+};
+
+/*
+    Barrett
+    -------
+    Barrett reduction modulo an m of any parity. The reciprocal
+    mu = (B^(2n) - 1) / m is computed once. The quotient of any x < B^(2n)
+    by m is then estimated from the top limbs of x * mu, and is at most 4
+    too small. So a reduction costs two products and a few subtractions,
+    and no division. Residues are kept as they are.
+*/
+
+struct Barrett
+{
+    Limbs m;             // the modulus
+    size_t n;
+    Limbs mu;            // (B^(2n) - 1) / m, n + 1 limbs
+    size_t scratch_size; // limbs of scratch space t that the operations need
+
+    Barrett() : n(0), scratch_size(0) {}
+
+    Barrett(const limb_t *modulus, size_t size)
+        : m(size), n(size), mu(size + 1), scratch_size(6 * size + 3)
+    {
+        std::copy(modulus, modulus + n, m.data());
+
+        // m >= B^(n-1), so mu < B^(n+1) even when m is a power of B
+        Limbs ones(2 * n);
+        std::fill(ones.begin(), ones.end(), ~(limb_t)0);
+        divrem(mu.data(), nullptr, ones.data(), 2 * n, m.data(), n);
+    }
+
+    // r = x mod m for x[0..2n), with t[0..4n+3) as scratch. r may alias x.
+    void reduce(limb_t *r, const limb_t *x, limb_t *t) const
+    {
+        limb_t *q = t, *p = t + 2 * n + 2;
+        const limb_t *x1 = x + n - 1;
+        if (n + 1 < KARATSUBA_THRESHOLD)
+        {
+            // Only the top n + 1 limbs of x1 * mu and the low n + 1 limbs of
+            // q * m are used, so the schoolbook products skip the others.
+            // The columns of x1 * mu below n - 1 add less than B^(n+1), so
+            // dropping them makes the quotient at most one smaller again.
+            q[n + 1] = mul_1(q + n - 1, x1 + n - 1, 2, mu[0]);
+            for (size_t j = 1; j <= n; j++)
+            {
+                size_t i = j < n - 1 ? n - 1 - j : 0;
+                q[n + 1 + j] = addmul_1(q + i + j, x1 + i, n + 1 - i, mu[j]);
+            }
+            mul_1(p, q + n + 1, n + 1, m[0]);
+            for (size_t j = 1; j < n; j++)
+                addmul_1(p + j, q + n + 1, n + 1 - j, m[j]);
+        }
+        else
+        {
+            ::mul(q, x1, n + 1, mu.data(), n + 1);
+            ::mul(p, q + n + 1, n + 1, m.data(), n);
+        }
+
+        // x - q * m < 5m < B^(n+1), so it can be worked out mod B^(n+1)
+        sub_n(p, x, p, n + 1);
+        while (p[n] || cmp_n(p, m.data(), n) >= 0)
+            p[n] -= sub_n(p, p, m.data(), n);
+        std::copy(p, p + n, r);
+    }
+
+    void mul(limb_t *r, const limb_t *a, const limb_t *b, limb_t *t) const
+    {
+        ::mul(t, a, n, b, n);
+        reduce(r, t, t + 2 * n);
+    }
+
+    void sqr(limb_t *r, const limb_t *a, limb_t *t) const
+    {
+        ::sqr(t, a, n);
+        reduce(r, t, t + 2 * n);
+    }
+
+    void to_form(limb_t *r, const limb_t *a, limb_t *) const { std::copy(a, a + n, r); }
+    void from_form(limb_t *r, const limb_t *a, limb_t *) const { std::copy(a, a + n, r); }
+};
+
+/*
+    powmod_window
+    -------------
+    r = g^e in the form of Modulus, for g[0..n) in that form and an
+    exponent e[0..en) with e[en-1] != 0. r may not alias g.
+*/
+
+template <class Modulus>
+void powmod_window(const Modulus &M, limb_t *r, const limb_t *g, const limb_t *e, size_t en)
+{
+    /**
+     * Complexity of powmod_window function
+     *
+     * Time complexity : O(k * M(n)) for a k bit exponent, where M(n) is the
+     *                   time of one modular product
+     * Space complexity: O(2^w * n) for a window of w bits
+     *
+     * Algorithm of powmod_window function
+     *      1. Pick the window width w from the length of the exponent, so
+     *         that the 2^(w-1) products of the table are paid back by the
+     *         k / (w+1) products of the scan
+     *      2. Tabulate the odd powers g, g^3, ..., g^(2^w - 1)
+     *      3. Scan the exponent from the top. A 0 bit is one squaring. At a
+     *         1 bit, take the longest run of at most w bits that ends in a
+     *         1 bit, square once per bit of it and multiply by its entry in
+     *         the table. The first run is copied from the table instead
+     */
+
+    ScratchScope scratch;
+    size_t n = M.n;
+    size_t bits = en * 64 - __builtin_clzll(e[en - 1]);
+    unsigned w = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 6 ? 2 : 1;
+    auto bit = [e](size_t i) { return (e[i / 64] >> (i % 64)) & 1; };
+
+    Limbs t(M.scratch_size), table(n << (w - 1));
+    std::copy(g, g + n, table.data());
+    if (w > 1)
+    {
+        Limbs g2(n);
+        M.sqr(g2.data(), g, t.data());
+        for (size_t i = 1; i < (size_t)1 << (w - 1); i++)
+            M.mul(table.data() + i * n, table.data() + (i - 1) * n, g2.data(), t.data());
+    }
+
+    // bits [0, top) are still to be scanned
+    bool started = false;
+    for (size_t top = bits; top > 0;)
+    {
+        if (!bit(top - 1))
+        {
+            M.sqr(r, r, t.data());
+            top--;
+            continue;
+        }
+
+        size_t low = top > w ? top - w : 0;
+        while (!bit(low))
+            low++;
+        size_t value = 0;
+        for (size_t i = top; i-- > low;)
+            value = 2 * value + bit(i);
+
+        const limb_t *entry = table.data() + (value >> 1) * n;
+        if (started)
+        {
+            for (size_t i = low; i < top; i++)
+                M.sqr(r, r, t.data());
+            M.mul(r, r, entry, t.data());
+        }
+        else
+        {
+            std::copy(entry, entry + n, r);
+            started = true;
+        }
+        top = low;
+    }
+}
+
+
+/*
+    ===========================================================================
+    Decimal conversion
+    ===========================================================================
+    Decimal text is converted 19 digits at a time, the largest power of ten
+    that fits in a single limb.
+*/
+
+const limb_t DECIMAL_BASE = 10000000000000000000ULL; // 10^19
+const int DECIMAL_BASE_DIGITS = 19;
+
+// 10^0 to 10^19, the powers of ten that fit in a limb
+constexpr limb_t LIMB_POWERS_OF_TEN[DECIMAL_BASE_DIGITS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+/*
+    decimal_to_limbs
+    ----------------
+    Parse a string of decimal digits (already validated) into a magnitude.
+*/
+
+Limbs decimal_to_limbs(const std::string &digits)
+{
+    Limbs result;
+    size_t len = digits.length();
+    size_t chunk = len % DECIMAL_BASE_DIGITS;
+    if (chunk == 0)
+        chunk = DECIMAL_BASE_DIGITS;
+
+    for (size_t pos = 0; pos < len; pos += chunk, chunk = DECIMAL_BASE_DIGITS)
+    {
+        limb_t value = 0;
+        for (size_t i = pos; i < pos + chunk; i++)
+            value = value * 10 + (digits[i] - '0');
+
+        limb_t carry = mul_1(result.data(), result.data(), result.size(), LIMB_POWERS_OF_TEN[chunk]);
+        if (carry)
+            result.push_back(carry);
+        carry = add_1(result.data(), result.data(), result.size(), value);
+        if (carry)
+            result.push_back(carry);
+    }
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    limbs_to_decimal
+    ----------------
+    Print a magnitude as decimal digits, without a sign.
+*/
+
+std::string limbs_to_decimal(const Limbs &num)
+{
+    if (num.empty())
+        return "0";
+
+    Limbs work = num;
+    std::vector<limb_t> chunks;
+    while (!work.empty())
+    {
+        chunks.push_back(divrem_1(work.data(), work.data(), work.size(), DECIMAL_BASE));
+        strip_leading_zeroes(work);
+    }
+
+    std::string result = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;)
+    {
+        std::string part = std::to_string(chunks[i]);
+        result.append(DECIMAL_BASE_DIGITS - part.length(), '0');
+        result += part;
+    }
+    return result;
+}
+
+/*
+    ===========================================================================
+    Conversion functions for BigInt
+    ===========================================================================
+*/
+
+/*
+    to_string
+    ---------
+    Converts a BigInt to a string.
+*/
+
+std::string BigInt::to_string() const
+{
+    // prefix with sign if negative
+    std::string digits = limbs_to_decimal(this->magnitude);
+    return this->signum == -1 ? "-" + digits : digits;
+}
+
+/*
+    to_long_long
+    ------------
+    Converts a BigInt to a long long int.
+    NOTE: If the BigInt is out of range of a long long int, an out_of_range
+    exception is thrown.
+*/
+
+long long BigInt::to_long_long() const
+{
+    if (this->magnitude.empty())
+        return 0;
+
+    limb_t value = this->magnitude[0];
+    limb_t limit = (limb_t)std::numeric_limits<long long>::max() + (this->signum == -1);
+    if (this->magnitude.size() > 1 || value > limit)
+        throw std::out_of_range("BigInt::to_long_long");
+
+    return this->signum == -1 ? (long long)(0 - value) : (long long)value;
+}
+
+/*
+    to_int
+    ------
+    Converts a BigInt to an int.
+    NOTE: If the BigInt is out of range of an int, an out_of_range exception
+    is thrown.
+*/
+
+int BigInt::to_int() const
+{
+    long long value = this->to_long_long();
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+        throw std::out_of_range("BigInt::to_int");
+    return (int)value;
+}
+
+/*
+    to_long
+    -------
+    Converts a BigInt to a long int.
+    NOTE: If the BigInt is out of range of a long int, an out_of_range
+    exception is thrown.
+*/
+
+long BigInt::to_long() const
+{
+    long long value = this->to_long_long();
+    if (value < std::numeric_limits<long>::min() || value > std::numeric_limits<long>::max())
+        throw std::out_of_range("BigInt::to_long");
+    return (long)value;
+}
+
+/*
+    Addition
+    --------
+    Limbs = |Limbs| + |Limbs|
+*/
+
+Limbs addition(const Limbs &s1, const Limbs &s2)
+{
+    /**
+     * Complexity of addition function
+     *
+     * Time complexity : O(n)
+     * Space complexity: O(n)
+     *
+     * Algorithm of addition function
+     *      1. Make sure s1 is the longer operand
+     *      2. Add the common limbs with carry (add_n)
+     *      3. Propagate the carry through the remaining limbs of s1
+     *      4. Append the final carry as a new top limb
+     */
+
+    if (is_small(s1) && is_small(s2))
+    {
+        dlimb_t x = limbs_to_dlimb(s1);
+        dlimb_t sum = x + limbs_to_dlimb(s2);
+        Limbs result = dlimb_to_limbs(sum);
+        if (sum < x)
+        {
+            // overflowed 128 bits, promote to a third limb
+            result.resize(2);
+            result.push_back(1);
+        }
+        return result;
+    }
+
+    const Limbs &longer = s1.size() >= s2.size() ? s1 : s2;
+    const Limbs &shorter = s1.size() >= s2.size() ? s2 : s1;
+
+    Limbs result(longer.size() + 1);
+    result[longer.size()] = add(result.data(), longer.data(), longer.size(),
+                                shorter.data(), shorter.size());
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    subtraction
+    -----------
+    Limbs = ||Limbs| - |Limbs||
+*/
+
+Limbs subtraction(const Limbs &s1, const Limbs &s2)
+{
+    /**
+     * Complexity of subtraction function
+     *
+     * Time complexity : O(n)
+     * Space complexity: O(n)
+     *
+     * Algorithm of subtraction function
+     *      1. Make sure s1 is larger than s2
+     *      2. Subtract the common limbs with borrow (sub_n)
+     *      3. Propagate the borrow through the remaining limbs of s1
+     *      4. Strip the zero limbs from the top
+     */
+
+    int val = magnitude_compare(s1, s2);
+    if (val == 0)
+        return Limbs();
+
+    if (is_small(s1) && is_small(s2))
+    {
+        dlimb_t x = limbs_to_dlimb(s1), y = limbs_to_dlimb(s2);
+        return dlimb_to_limbs(val > 0 ? x - y : y - x);
+    }
+
+    const Limbs &larger = val > 0 ? s1 : s2;
+    const Limbs &smaller = val > 0 ? s2 : s1;
+
+    Limbs result(larger.size());
+    sub(result.data(), larger.data(), larger.size(), smaller.data(), smaller.size());
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    add_limbs
+    ---------
+    |acc| = |acc| + |num|, in the buffer of acc. num may be acc itself.
+*/
+
+void add_limbs(Limbs &acc, const Limbs &num)
+{
+    size_t an = acc.size(), bn = num.size();
+    limb_t carry;
+
+    if (an >= bn)
+    {
+        carry = add(acc.data(), acc.data(), an, num.data(), bn);
+    }
+    else
+    {
+        acc.resize(bn);
+        carry = add(acc.data(), num.data(), bn, acc.data(), an);
+    }
+
+    if (carry)
+        acc.push_back(carry);
+}
+
+/*
+    sub_limbs
+    ---------
+    |acc| = ||acc| - |num||, in the buffer of acc. Returns true when num was
+    the larger one.
+*/
+
+bool sub_limbs(Limbs &acc, const Limbs &num)
+{
+    size_t an = acc.size(), bn = num.size();
+    bool swapped = magnitude_compare(acc, num) < 0;
+
+    if (!swapped)
+    {
+        sub(acc.data(), acc.data(), an, num.data(), bn);
+    }
+    else
+    {
+        acc.resize(bn);
+        sub(acc.data(), num.data(), bn, acc.data(), an);
+    }
+
+    strip_leading_zeroes(acc);
+    return swapped;
+}
+
+/*
+    addmul_limbs
+    ------------
+    |acc| = |acc| + a[0..an) * b[0..bn), or ||acc| - a * b| when subtract is
+    set, in the buffer of acc. Returns true when a * b was the larger one.
+    Neither operand may live in acc.
+*/
+
+bool addmul_limbs(Limbs &acc, const limb_t *a, size_t an, const limb_t *b, size_t bn, bool subtract)
+{
+    /**
+     * Complexity of addmul_limbs function
+     *
+     * Time complexity : O(an*bn) for short operands, else that of mul()
+     * Space complexity: O(1) for short operands, else O(an+bn)
+     *
+     * Algorithm of addmul_limbs function
+     *      1. Make a the longer operand
+     *      2. If b is long enough for Karatsuba, form the product with mul()
+     *         and add or subtract it in place
+     *      3. Otherwise widen acc and add (or subtract) a * b[j] at limb j
+     *         for every limb of b with addmul_1 (submul_1), carrying into
+     *         the limbs above
+     *      4. A subtraction that borrowed out of the top left
+     *         B^len - (a*b - |acc|), so negate it in two's complement
+     */
+
+    if (an < bn)
+    {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+
+    if (bn == 0)
+        return false;
+
+    if (bn >= KARATSUBA_THRESHOLD)
+    {
+        Limbs product = scratch_limbs(an + bn);
+        mul(product.data(), a, an, b, bn);
+        strip_leading_zeroes(product);
+
+        if (!subtract)
+        {
+            add_limbs(acc, product);
+            return false;
+        }
+        return sub_limbs(acc, product);
+    }
+
+    size_t len = std::max(acc.size(), an + bn) + !subtract;
+    acc.resize(len);
+    limb_t *r = acc.data();
+
+    limb_t borrow = 0;
+    for (size_t j = 0; j < bn; j++)
+    {
+        if (!subtract)
+        {
+            limb_t carry = addmul_1(r + j, a, an, b[j]);
+            add_1(r + j + an, r + j + an, len - j - an, carry);
+        }
+        else
+        {
+            limb_t out = submul_1(r + j, a, an, b[j]);
+            borrow |= sub_1(r + j + an, r + j + an, len - j - an, out);
+        }
+    }
+
+    if (borrow)
+    {
+        size_t i = 0;
+        while (r[i] == 0)
+            i++;
+        r[i] = 0 - r[i];
+        for (i++; i < len; i++)
+            r[i] = ~r[i];
+    }
+
+    strip_leading_zeroes(acc);
+    return borrow != 0;
+}
+
+/*
+    Multiplication
+    --------------
+    Limbs = |Limbs| * |Limbs|
+*/
+
+Limbs multiplication(const Limbs &s1, const Limbs &s2)
+{
+    /**
+     * Complexity of multiplication function
+     *
+     * Time complexity : O(n*m) for short operands, down to O(n log n)
+     * Space complexity: O(n+m)
+     *
+     * Algorithm of multiplication function
+     *      1. Return zero if either operand is zero
+     *      2. Use native 128-bit arithmetic when the product fits
+     *      3. Otherwise hand the longer and the shorter operand to mul(),
+     *         which picks schoolbook, Karatsuba, Toom-3, Toom-4 or NTT by
+     *         size. Passing the same Limbs twice gives a square, which
+     *         mul() hands to the cheaper sqr() kernels
+     *      4. Strip the zero limbs from the top
+     */
+
+    if (s1.empty() || s2.empty())
+        return Limbs();
+
+    dlimb_t product;
+    if (is_small(s1) && is_small(s2)
+        && !__builtin_mul_overflow(limbs_to_dlimb(s1), limbs_to_dlimb(s2), &product))
+        return dlimb_to_limbs(product);
+
+    const Limbs &longer = s1.size() >= s2.size() ? s1 : s2;
+    const Limbs &shorter = s1.size() >= s2.size() ? s2 : s1;
+
+    Limbs result(s1.size() + s2.size());
+    mul(result.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    Division
+    --------
+    Limbs = |Limbs| / |Limbs|
+*/
+
+Limbs division(const Limbs &s1, const Limbs &s2)
+{
+    /**
+     * Complexity of division function
+     *
+     * Time complexity : O((n-m)*m)
+     * Space complexity: O(n)
+     *
+     * Algorithm of division function
+     *      1. Handle division by zero and the trivial cases
+     *      2. Use native 128-bit arithmetic for small operands
+     *      3. Otherwise run Knuth's Algorithm D through divrem()
+     *      4. Strip the zero limbs from the top
+     */
+
+    if (s2.empty())
+    {
+        std::cout << "Can't divided by zero" <<std:: endl;
+        exit(1);
+    }
+    else if (s1.empty())
+    {
+        return Limbs();
+    }
+
+    int val = magnitude_compare(s1, s2);
+
+    if (val == -1)
+        return Limbs();
+    else if (val == 0)
+        return Limbs(1, 1);
+
+    if (is_small(s1))
+        return dlimb_to_limbs(limbs_to_dlimb(s1) / limbs_to_dlimb(s2));
+
+    Limbs result(s1.size() - s2.size() + 1);
+    divrem(result.data(), nullptr, s1.data(), s1.size(), s2.data(), s2.size());
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    Remainder
+    ---------
+    Limbs = |Limbs| % |Limbs|
+*/
+
+Limbs remainder(const Limbs &s1, const Limbs &s2)
+{
+    /**
+     * Complexity of remainder function
+     *
+     * Time complexity : O((n-m)*m)
+     * Space complexity: O(n)
+     *
+     * Algorithm of remainder function
+     *      1. Handle division by zero and the trivial cases
+     *      2. Use native 128-bit arithmetic for small operands
+     *      3. Otherwise run Knuth's Algorithm D through divrem()
+     *      4. Strip the zero limbs from the top
+     */
+
+    if (s2.empty())
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
+    else if (s1.empty())
+    {
+        return Limbs();
+    }
+
+    int val = magnitude_compare(s1, s2);
+
+    if (val == -1)
+        return s1;
+    else if (val == 0)
+        return Limbs();
+
+    if (is_small(s1))
+        return dlimb_to_limbs(limbs_to_dlimb(s1) % limbs_to_dlimb(s2));
+
+    Limbs result(s2.size());
+    divrem(nullptr, result.data(), s1.data(), s1.size(), s2.data(), s2.size());
+
+    strip_leading_zeroes(result);
+    return result;
+}
+
+/*
+    Quotient and remainder
+    ----------------------
+    quotient = |s1| / |s2| and rem = |s1| % |s2| from a single division.
+*/
+
+void division_remainder(const Limbs &s1, const Limbs &s2, Limbs &quotient, Limbs &rem)
+{
+    if (s2.empty())
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
+
+    int val = magnitude_compare(s1, s2);
+
+    if (val == -1)
+    {
+        quotient.clear();
+        rem = s1;
+        return;
+    }
+    else if (val == 0)
+    {
+        quotient = Limbs(1, 1);
+        rem.clear();
+        return;
+    }
+
+    if (is_small(s1))
+    {
+        dlimb_t x = limbs_to_dlimb(s1), y = limbs_to_dlimb(s2);
+        quotient = dlimb_to_limbs(x / y);
+        rem = dlimb_to_limbs(x % y);
+        return;
+    }
+
+    quotient = Limbs(s1.size() - s2.size() + 1);
+    rem = Limbs(s2.size());
+    divrem(quotient.data(), rem.data(), s1.data(), s1.size(), s2.data(), s2.size());
+
+    strip_leading_zeroes(quotient);
+    strip_leading_zeroes(rem);
+}
+
+/*
+    divide_in_place
+    ---------------
+    |num| = |num| / |d|, or |num| % |d| when remainder is set, in the buffer
+    of num. The dividend is copied to scratch space for the division.
+*/
+
+void divide_in_place(Limbs &num, const Limbs &d, bool remainder)
+{
+    if (d.empty())
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
+
+    int val = magnitude_compare(num, d);
+
+    if (val == -1)
+    {
+        if (!remainder)
+            num.clear();
+        return;
+    }
+    else if (val == 0)
+    {
+        num.clear();
+        if (!remainder)
+            num.push_back(1);
+        return;
+    }
+
+    if (is_small(num))
+    {
+        dlimb_t x = limbs_to_dlimb(num), y = limbs_to_dlimb(d);
+        num = dlimb_to_limbs(remainder ? x % y : x / y);
+        return;
+    }
+
+    size_t an = num.size(), dn = d.size();
+    const Limbs &source = num;
+    Limbs dividend = scratch_limbs(an);
+    std::copy(source.begin(), source.end(), dividend.data());
+
+    num.clear();
+    num.resize(remainder ? dn : an - dn + 1);
+    if (remainder)
+        divrem(nullptr, num.data(), dividend.data(), an, d.data(), dn);
+    else
+        divrem(num.data(), nullptr, dividend.data(), an, d.data(), dn);
+    strip_leading_zeroes(num);
+}
+
+/*
+    ===========================================================================
+    Single limb arithmetic
+    ===========================================================================
+    In-place versions of the functions above for a one-limb second operand,
+    used by the BigInt op Integer operators. They run one O(n) pass of the
+    limb kernels over num itself, and only touch the allocator when the
+    magnitude grows by a limb.
+*/
+
+/*
+    add_limb
+    --------
+    |num| = |num| + w
+*/
+
+void add_limb(Limbs &num, limb_t w)
+{
+    limb_t carry = add_1(num.data(), num.data(), num.size(), w);
+    if (carry)
+        num.push_back(carry);
+}
+
+/*
+    sub_limb
+    --------
+    |num| = ||num| - w|, returns true when w was the larger one.
+*/
+
+bool sub_limb(Limbs &num, limb_t w)
+{
+    if (num.size() <= 1 && (num.empty() || num[0] < w))
+    {
+        limb_t diff = w - (num.empty() ? 0 : num[0]);
+        num.clear();
+        num.push_back(diff);
+        return true;
+    }
+
+    sub_1(num.data(), num.data(), num.size(), w);
+    strip_leading_zeroes(num);
+    return false;
+}
+
+/*
+    mul_limb
+    --------
+    |num| = |num| * w
+*/
+
+void mul_limb(Limbs &num, limb_t w)
+{
+    if (w == 0)
+    {
+        num.clear();
+        return;
+    }
+
+    limb_t carry = mul_1(num.data(), num.data(), num.size(), w);
+    if (carry)
+        num.push_back(carry);
+}
+
+/*
+    divrem_limb
+    -----------
+    |num| = |num| / w, returns |num| % w.
+*/
+
+limb_t divrem_limb(Limbs &num, limb_t w)
+{
+    if (w == 0)
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
+
+    limb_t rem = divrem_1(num.data(), num.data(), num.size(), w);
+    strip_leading_zeroes(num);
+    return rem;
+}
+
+/*
+    ===========================================================================
+    Constants
+    ===========================================================================
+    Tables of values that are built once and shared by all operations: the
+    integers from -SMALL_CONSTANT_LIMIT to SMALL_CONSTANT_LIMIT, and the
+    powers of two and of ten below 2^POWER_TABLE_SIZE and 10^POWER_TABLE_SIZE.
+    Each table is built on first use and never changes afterwards, so the
+    references stay valid until the program exits. An index out of range
+    throws out_of_range.
+*/
+
+const int SMALL_CONSTANT_LIMIT = 256;
+const size_t POWER_TABLE_SIZE = 512;
+
+/*
+    build_table
+    -----------
+    The table {value(0), value(1), ... value(n-1)}, where value(i) may use
+    the entries before it. The limbs come from new[] whatever allocator is
+    current, since the table outlives any arena.
+*/
+
+template <class Function>
+std::vector<BigInt> build_table(size_t n, Function value)
+{
+    BigIntAllocatorScope scope(nullptr);
+    std::vector<BigInt> table;
+    table.reserve(n);
+    for (size_t i = 0; i < n; i++)
+        table.push_back(value(table, i));
+    return table;
+}
+
+const BigInt &bigint_constant(int value)
+{
+    static const std::vector<BigInt> table =
+        build_table(2 * SMALL_CONSTANT_LIMIT + 1, [](const std::vector<BigInt> &, size_t i) {
+            return BigInt((long long)i - SMALL_CONSTANT_LIMIT);
+        });
+
+    if (value < -SMALL_CONSTANT_LIMIT || value > SMALL_CONSTANT_LIMIT)
+        throw std::out_of_range("bigint_constant");
+    return table[value + SMALL_CONSTANT_LIMIT];
+}
+
+const BigInt &bigint_power_of_two(size_t exponent)
+{
+    static const std::vector<BigInt> table =
+        build_table(POWER_TABLE_SIZE, [](const std::vector<BigInt> &, size_t i) {
+            return BigInt(1) << i;
+        });
+
+    if (exponent >= POWER_TABLE_SIZE)
+        throw std::out_of_range("bigint_power_of_two");
+    return table[exponent];
+}
+
+const BigInt &bigint_power_of_ten(size_t exponent)
+{
+    static const std::vector<BigInt> table =
+        build_table(POWER_TABLE_SIZE, [](const std::vector<BigInt> &powers, size_t i) {
+            return i == 0 ? BigInt(1) : powers[i - 1] * 10;
+        });
+
+    if (exponent >= POWER_TABLE_SIZE)
+        throw std::out_of_range("bigint_power_of_ten");
+    return table[exponent];
+}
+
+/*
+    Return size of bigint
+    ---------------------
+    Number of decimal digits.
+*/
+
+int BigInt::length() const
+{
+    /**
+     * Algorithm of length function
+     *      1. For a value of b bits, 2^(b-1) <= |x| < 2^b, so x has d or
+     *         d + 1 digits, with d - 1 = floor((b - 1) log10(2)). That is
+     *         computed with log10(2) to 128 bits, exact for any b below
+     *         2^60
+     *      2. |x| >= 10^d decides between them. Below the table of powers
+     *         of ten that is one comparison. Above it, compare b - 1 and
+     *         then log2 of the top 64 bits of x with d log2(10), computed
+     *         to 128 bits. Only when the logarithms are within 2^-40 is
+     *         10^d built to compare exactly
+     */
+
+    const Limbs &num = this->magnitude;
+    if (num.empty())
+        return 1;
+
+    const limb_t LOG10_2_HIGH = 0x4d104d427de7fbccULL, LOG10_2_LOW = 0x47c4acd605be48bcULL;
+    size_t n = num.size();
+    unsigned lead = __builtin_clzll(num[n - 1]);
+    limb_t top_bit = n * 64 - lead - 1;
+    dlimb_t low = ((dlimb_t)top_bit * LOG10_2_LOW) >> 64;
+    size_t digits = (size_t)(((dlimb_t)top_bit * LOG10_2_HIGH + low) >> 64) + 1;
+
+    if (digits < POWER_TABLE_SIZE)
+        return digits + (magnitude_compare(num, bigint_power_of_ten(digits).magnitude) >= 0);
+
+    // d log2(10) = whole + fraction / 2^64, from log2(10) - 3 to 128 bits
+    const limb_t LOG2_10_HIGH = 0x5269e12f346e2bf9ULL, LOG2_10_LOW = 0x24afdbfd36bf6d33ULL;
+    dlimb_t scaled = (dlimb_t)digits * LOG2_10_HIGH + (((dlimb_t)digits * LOG2_10_LOW) >> 64);
+    dlimb_t whole = (dlimb_t)digits * 3 + (scaled >> 64);
+    if (top_bit != whole)
+        return digits + (top_bit > whole);
+
+    // log2(|x|) - top_bit from its top 64 bits, against the fraction
+    limb_t top = num[n - 1] << lead;
+    if (lead && n > 1)
+        top |= num[n - 2] >> (64 - lead);
+    long double difference = log2l((long double)top) - 63 - (long double)(limb_t)scaled / 18446744073709551616.0L;
+    if (difference > 1e-12L || difference < -1e-12L)
+        return digits + (difference > 0);
+
+    BigInt power = pow(bigint_constant(10), digits);
+    return digits + (magnitude_compare(num, power.magnitude) >= 0);
+}
+
+/*
+    Access digit
+    ---------------
+    return specific decimal digit by given index, counting from the most
+    significant one. Each call divides by a power of ten, so to visit every
+    digit of a large value convert it once with to_string() instead.
+*/
+
+BigInt BigInt::operator[](int index) const
+{
+    int digits = this->length();
+    if (index < 0 || digits <= index)
+    {
+        std::cout << "Error: Index out of bounds" << std::endl;
+        exit(1);
+    }
+
+    // the digit is the last one of |x| / 10^(digits - 1 - index)
+    BigInt high = this->signum == -1 ? -*this : *this;
+    if (index < digits - 1)
+        high /= pow(bigint_constant(10), digits - 1 - index);
+    Limbs &num = high.magnitude;
+    return bigint_constant(num.empty() ? 0 : (int)divrem_1(num.data(), num.data(), num.size(), 10));
+}
+
+/*
+    Logical and
+    -----------
+    BigInt && BigInt
+*/
+
+bool BigInt::operator&&(const BigInt &obj) const
+{
+    return !this->is_zero() && !obj.is_zero();
+}
+
+/*
+    Logical or
+    -----------
+    BigInt || BigInt
+*/
+
+bool BigInt::operator||(const BigInt &obj) const
+{
+    return !this->is_zero() || !obj.is_zero();
+}
+
+/*
+    Logical not
+    -----------
+    !BigInt
+*/
+
+bool BigInt::operator!() const
+{
+    return this->is_zero();
+}
+
+/*
+    Sign queries
+    ------------
+    is_zero, is_one and sign (-1, 0 or 1) only look at the number of limbs
+    and the sign, so they take O(1).
+*/
+
+bool BigInt::is_zero() const
+{
+    return this->magnitude.empty();
+}
+
+bool BigInt::is_one() const
+{
+    return this->magnitude.size() == 1 && this->magnitude[0] == 1 && this->signum == 1;
+}
+
+int BigInt::sign() const
+{
+    return this->magnitude.empty() ? 0 : this->signum;
+}
+
+// Pre-increment
+// += Integer stops at the first limb that does not carry, so counting is
+// amortized O(1) and never allocates until the magnitude grows a limb.
+BigInt &BigInt::operator++()
+{
+    *this += 1;
+    return *this;
+}
+// Post-increment
+BigInt BigInt::operator++(int)
+{
+    BigInt temp = *this;
+    ++*this;
+    return temp;
+}
+// Pre-decrement
+BigInt &BigInt::operator--()
+{
+    *this -= 1;
+    return *this;
+}
+// Post-decrement
+BigInt BigInt::operator--(int)
+{
+    BigInt temp = *this;
+    --*this;
+    return temp;
+}
+
+
+/*
+    istream operator overlaod
+    -------------------------
+    example: cin >> bigInt
+*/
+
+std::istream &operator>>(std::istream &input, BigInt &obj)
+{
+    std::string inputNum;
+
+    input >> inputNum;
+
+    if (inputNum.empty())
+    {
+        obj.magnitude.clear();
+        obj.signum = 1;
+        return input;
+    }
+
+    obj = inputNum;
+
+    return input;
+}
+
+/*
+    ostream operator overlaod
+    -------------------------
+    example: std::cout << bigInt
+*/
+
+std::ostream &operator<<(std::ostream &output, const BigInt &obj)
+{
+    output << obj.to_string();
+
+    return output;
+}
+
+/*
+    ===========================================================================
+    Constructors
+    ===========================================================================
+*/
+
+/*
+    Default constructor
+    -------------------
+*/
+
+BigInt::BigInt()
+{
+    signum = 1;
+}
+
+/*
+    Copy constructor
+    ----------------
+*/
+
+BigInt::BigInt(const BigInt &num)
+{
+    magnitude = num.magnitude;
+    signum = num.signum;
+}
+
+/*
+    Unshared copy
+    -------------
+    A copy of num that doesn't share its buffer, with room for capacity
+    limbs, for the operators that copy *this and then modify the copy.
+*/
+
+BigInt::BigInt(const BigInt &num, size_t capacity) : magnitude(num.magnitude, capacity)
+{
+    signum = num.signum;
+}
+
+/*
+    Move constructor
+    ----------------
+    Takes over the limbs of num, which is left as zero.
+*/
+
+BigInt::BigInt(BigInt &&num) noexcept : magnitude(std::move(num.magnitude))
+{
+    signum = num.signum;
+    num.signum = 1;
+}
+
+/*
+    String to BigInt
+    ----------------
+*/
+
+BigInt::BigInt(const std::string &num)
+{
+    if(num[0] == '+' or num[0] == '-')// check for sign
+    {
+        std::string digits = num.substr(1);
+        if(is_valid_number(digits))
+        {
+            magnitude = decimal_to_limbs(digits);
+            signum = (num[0] == '+') ? 1 : -1;
+        }
+        else
+        {
+            throw std::invalid_argument("Expected an integer, got \'" + num + "\'");
+        }
+    }
+    else// if no sign is specified
+    {
+        if(is_valid_number(num))
+        {
+            magnitude = decimal_to_limbs(num);
+            signum = 1; // positive by default
+        }
+        else
+        {
+            throw std::invalid_argument("Expected an integer, got \'" + num + "\'");
+        }
+
+    }
+
+    if(signum == -1 && magnitude.empty())
+        signum = 1;
+}
+
+/*
+    Integer to BigInt
+    -----------------
+*/
+BigInt::BigInt(const long long &ll)
+{
+    limb_t value = integer_magnitude(ll);
+    if (value)
+        magnitude.push_back(value);
+    signum = ll < 0 ? -1 : 1;
+}
+
+/*
+    ===========================================================================
+    Assignment operators
+    ===========================================================================
+*/
+
+
+/*
+    BigInt = BigInt
+    ---------------
+*/
+
+BigInt& BigInt::operator=(const BigInt &num)
+{
+    magnitude = num.magnitude;
+    signum = num.signum;
+
+    return *this;
+}
+
+/*
+    BigInt = temporary BigInt
+    -------------------------
+*/
+
+BigInt& BigInt::operator=(BigInt &&num) noexcept
+{
+    magnitude = std::move(num.magnitude);
+    signum = num.signum;
+    num.signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt = Integer
+    ----------------
+*/
+
+BigInt& BigInt::operator=(const long long &num)
+{
+    magnitude.clear();
+    if (num != 0)
+        magnitude.push_back(integer_magnitude(num));
+    signum = num < 0 ? -1 : 1;
+
+    return *this;
+}
+
+/*
+    BigInt = String
+    ---------------
+*/
+
+BigInt& BigInt::operator=(const std::string &num)
+{
+    *this = BigInt(num);
+
+    return *this;
+}
+
+
+/*
+    ===========================================================================
+    Unary arithmetic operators
+    ===========================================================================
+*/
+
+/*
+    +BigInt
+    -------
+    Returns the value of a BigInt.
+*/
+
+BigInt BigInt::operator+() const
+{
+    return *this;
+}
+
+/*
+    -BigInt
+    -------
+    Returns the negative of a BigInt.
+*/
+
+BigInt BigInt::operator-() const &
+{
+    BigInt temp;
+
+    temp.magnitude = magnitude;
+    if(!magnitude.empty())
+    {
+        if(signum == 1)
+            temp.signum = -1;
+        else
+            temp.signum = 1;
+    }
+
+    return temp;
+}
+
+BigInt BigInt::operator-() &&
+{
+    if (!magnitude.empty())
+        signum = -signum;
+
+    return std::move(*this);
+}
+
+
+
+
+/*
+    ===========================================================================
+    Binary arithmetic operators
+    ===========================================================================
+*/
+
+/*
+    BigInt + BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator+(const BigInt &obj) const &
+{
+    BigInt object;
+
+    if (this->signum == obj.signum)
+    {
+        object.magnitude = addition(this->magnitude, obj.magnitude);
+        object.signum = this->signum;
+    }
+    else
+    {
+        object.magnitude = subtraction(this->magnitude, obj.magnitude);
+
+        int val = magnitude_compare(this->magnitude, obj.magnitude);
+
+        if (val == 1)
+        {
+            object.signum = this->signum;
+        }
+        else if (val == -1)
+        {
+            object.signum = obj.signum;
+        }
+        else
+        {
+            object.signum = 1;
+        }
+    }
+
+    if (object.magnitude.empty())
+        object.signum = 1;
+
+    return object;
+}
+
+/*
+    BigInt + BigInt, with a temporary operand
+    -----------------------------------------
+    The sum is added into the buffer of the temporary, so a chain such as
+    a + b + c + d allocates only for the first sum.
+*/
+
+BigInt BigInt::operator+(const BigInt &obj) &&
+{
+    *this += obj;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator+(BigInt &&obj) const &
+{
+    obj += *this;
+    return std::move(obj);
+}
+
+BigInt BigInt::operator+(BigInt &&obj) &&
+{
+    *this += obj;
+    return std::move(*this);
+}
+
+/*
+    BigInt - BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator-(const BigInt &obj) const &
+{
+    BigInt object;
+
+    if (this->signum != obj.signum)
+    {
+        object.magnitude = addition(this->magnitude, obj.magnitude);
+        object.signum = this->signum;
+    }
+    else
+    {
+        object.magnitude = subtraction(this->magnitude, obj.magnitude);
+
+        if (magnitude_compare(this->magnitude, obj.magnitude) >= 0)
+            object.signum = this->signum;
+        else
+            object.signum = -obj.signum;
+    }
+
+    if (object.magnitude.empty())
+        object.signum = 1;
+
+    return object;
+}
+
+/*
+    BigInt - BigInt, with a temporary operand
+    -----------------------------------------
+*/
+
+BigInt BigInt::operator-(const BigInt &obj) &&
+{
+    *this -= obj;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator-(BigInt &&obj) const &
+{
+    // a - b = -(b - a)
+    obj -= *this;
+    return -std::move(obj);
+}
+
+BigInt BigInt::operator-(BigInt &&obj) &&
+{
+    *this -= obj;
+    return std::move(*this);
+}
+
+/*
+    BigInt * BigInt
+    ---------------
+    x * x reaches multiplication() with the same magnitude twice and is
+    squared.
+*/
+
+BigInt BigInt::operator*(const BigInt &obj) const
+{
+    BigInt object;
+
+    object.magnitude = multiplication(this->magnitude, obj.magnitude);
+
+    if (object.magnitude.empty())
+        object.signum = 1;
+    else
+        object.signum = this->signum * obj.signum;
+
+    return object;
+}
+
+/*
+    square
+    ------
+    Returns BigInt * BigInt, using the squaring kernels.
+*/
+
+BigInt BigInt::square() const
+{
+    BigInt object;
+
+    object.magnitude = multiplication(this->magnitude, this->magnitude);
+
+    return object;
+}
+
+/*
+    BigInt / BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator/(const BigInt &obj) const
+{
+    BigInt resultObject;
+
+    resultObject.magnitude = division(this->magnitude, obj.magnitude);
+
+    if (resultObject.magnitude.empty())
+        resultObject.signum = 1;
+    else
+        resultObject.signum = this->signum * obj.signum;
+
+    return resultObject;
+}
+
+/*
+    BigInt % BigInt
+    ---------------
+*/
+
+BigInt BigInt::operator%(const BigInt &obj) const
+{
+    BigInt resultObject;
+
+    resultObject.magnitude = remainder(this->magnitude, obj.magnitude);
+
+    if (resultObject.magnitude.empty())
+        resultObject.signum = 1;
+    else
+        resultObject.signum = this->signum;
+
+    return resultObject;
+}
+
+/*
+    addmul / submul
+    ---------------
+    BigInt += a * b and BigInt -= a * b, accumulated straight into the limbs
+    of the BigInt. Below KARATSUBA_THRESHOLD no product is formed at all.
+*/
+
+BigInt &BigInt::addmul(const BigInt &a, const BigInt &b)
+{
+    add_product(a, b, false);
+    return *this;
+}
+
+BigInt &BigInt::submul(const BigInt &a, const BigInt &b)
+{
+    add_product(a, b, true);
+    return *this;
+}
+
+BigInt &BigInt::addmul(const BigInt &a, const long long &num)
+{
+    limb_t w = integer_magnitude(num);
+    if (this == &a)
+        return addmul(BigInt(a), num);
+
+    add_product(a.magnitude.data(), a.magnitude.size(), &w, w != 0,
+                num < 0 ? -a.signum : a.signum);
+    return *this;
+}
+
+BigInt &BigInt::submul(const BigInt &a, const long long &num)
+{
+    limb_t w = integer_magnitude(num);
+    if (this == &a)
+        return submul(BigInt(a), num);
+
+    add_product(a.magnitude.data(), a.magnitude.size(), &w, w != 0,
+                num < 0 ? a.signum : -a.signum);
+    return *this;
+}
+
+/*
+    divmod
+    ------
+    Returns {BigInt / BigInt, BigInt % BigInt} from one division. The
+    quotient is truncated toward zero, as for / and %.
+*/
+
+std::pair<BigInt, BigInt> BigInt::divmod(const BigInt &obj) const
+{
+    BigInt quotient, rem;
+
+    division_remainder(this->magnitude, obj.magnitude, quotient.magnitude, rem.magnitude);
+
+    if (!quotient.magnitude.empty())
+        quotient.signum = this->signum * obj.signum;
+    if (!rem.magnitude.empty())
+        rem.signum = this->signum;
+
+    return {std::move(quotient), std::move(rem)};
+}
+
+/*
+    floor_divmod
+    ------------
+    Returns {floor(BigInt / BigInt), remainder} from one division. The
+    remainder is zero or has the sign of the divisor.
+*/
+
+std::pair<BigInt, BigInt> BigInt::floor_divmod(const BigInt &obj) const
+{
+    std::pair<BigInt, BigInt> result = this->divmod(obj);
+
+    if (!result.second.magnitude.empty() && this->signum != obj.signum)
+    {
+        result.first -= 1;
+        result.second += obj;
+    }
+
+    return result;
+}
+
+/*
+    BigInt + Integer
+    ----------------
+*/
+
+BigInt BigInt::operator+(const long long &num) const &
+{
+    BigInt object(*this, this->magnitude.size() + 1);
+    object += num;
+
+    return object;
+}
+
+BigInt BigInt::operator+(const long long &num) &&
+{
+    *this += num;
+    return std::move(*this);
+}
+
+/*
+    Integer + BigInt
+    ----------------
+*/
+
+BigInt operator+(const long long &lhs, const BigInt &rhs)
+{
+    BigInt object(rhs);
+    object += lhs;
+
+    return object;
+}
+
+BigInt operator+(const long long &lhs, BigInt &&rhs)
+{
+    rhs += lhs;
+    return std::move(rhs);
+}
+
+/*
+    BigInt - Integer
+    ----------------
+*/
+
+BigInt BigInt::operator-(const long long &num) const &
+{
+    BigInt object(*this, this->magnitude.size() + 1);
+    object -= num;
+
+    return object;
+}
+
+BigInt BigInt::operator-(const long long &num) &&
+{
+    *this -= num;
+    return std::move(*this);
+}
+
+/*
+    Integer - BigInt
+    ----------------
+*/
+
+BigInt operator-(const long long &lhs, const BigInt &rhs)
+{
+    BigInt object = -rhs;
+    object += lhs;
+
+    return object;
+}
+
+BigInt operator-(const long long &lhs, BigInt &&rhs)
+{
+    BigInt object = -std::move(rhs);
+    object += lhs;
+
+    return object;
+}
+
+/*
+    BigInt * Integer
+    ----------------
+*/
+
+BigInt BigInt::operator*(const long long &num) const &
+{
+    BigInt object(*this, this->magnitude.size() + 1);
+    object *= num;
+
+    return object;
+}
+
+BigInt BigInt::operator*(const long long &num) &&
+{
+    *this *= num;
+    return std::move(*this);
+}
+
+/*
+    Integer * BigInt
+    ----------------
+*/
+
+BigInt operator*(const long long &lhs, const BigInt &rhs)
+{
+    BigInt object(rhs);
+    object *= lhs;
+
+    return object;
+}
+
+BigInt operator*(const long long &lhs, BigInt &&rhs)
+{
+    rhs *= lhs;
+    return std::move(rhs);
+}
+
+/*
+    BigInt / Integer
+    ----------------
+*/
+
+BigInt BigInt::operator/(const long long &num) const &
+{
+    BigInt object(*this, this->magnitude.size());
+    object /= num;
+
+    return object;
+}
+
+BigInt BigInt::operator/(const long long &num) &&
+{
+    *this /= num;
+    return std::move(*this);
+}
+
+/*
+    Integer / BigInt
+    ----------------
+*/
+
+BigInt operator/(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) / rhs;
+}
+
+/*
+    BigInt % Integer
+    ----------------
+*/
+
+BigInt BigInt::operator%(const long long &num) const
+{
+    limb_t w = integer_magnitude(num);
+    if (w == 0)
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
+
+    BigInt object;
+    limb_t rem = mod_1(this->magnitude.data(), this->magnitude.size(), w);
+    if (rem)
+    {
+        object.magnitude.push_back(rem);
+        object.signum = this->signum;
+    }
+
+    return object;
+}
+
+/*
+    Integer % BigInt
+    ----------------
+*/
+
+BigInt operator%(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) % rhs;
+}
+
+/*
+    BigInt + String
+    ---------------
+*/
+
+BigInt BigInt::operator+(const std::string &num) const
+{
+    return *this + BigInt(num);
+}
+
+/*
+    String + BigInt
+    ---------------
+*/
+
+BigInt operator+(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) + rhs;
+}
+
+/*
+    BigInt - String
+    ---------------
+*/
+
+BigInt BigInt::operator-(const std::string &num) const
+{
+    return *this - BigInt(num);
+}
+
+/*
+    String - BigInt
+    ---------------
+*/
+
+BigInt operator-(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) - rhs;
+}
+
+/*
+    BigInt * String
+    ---------------
+*/
+
+BigInt BigInt::operator*(const std::string &num) const
+{
+    return *this * BigInt(num);
+}
+
+/*
+    String * BigInt
+    ---------------
+*/
+
+BigInt operator*(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) * rhs;
+}
+
+/*
+    BigInt / String
+    ---------------
+*/
+
+BigInt BigInt::operator/(const std::string &num) const
+{
+    return *this / BigInt(num);
+}
+
+/*
+    String / BigInt
+    ---------------
+*/
+
+BigInt operator/(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) / rhs;
+}
+
+/*
+    BigInt % String
+    ---------------
+*/
+
+BigInt BigInt::operator%(const std::string &num) const
+{
+    return *this % BigInt(num);
+}
+
+/*
+    String % BigInt
+    ---------------
+*/
+
+BigInt operator%(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) % rhs;
+}
+
+
+/*
+    ===========================================================================
+    Arithmetic-assignment operators
+    ===========================================================================
+*/
+
+/*
+    BigInt += BigInt
+    -----------------
+*/
+
+BigInt &BigInt::operator+=(const BigInt &obj)
+{
+    if (this->signum == obj.signum)
+        add_limbs(this->magnitude, obj.magnitude);
+    else if (sub_limbs(this->magnitude, obj.magnitude))
+        this->signum = obj.signum;
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt -= BigInt
+    -----------------
+*/
+
+BigInt &BigInt::operator-=(const BigInt &obj)
+{
+    if (this->signum != obj.signum)
+        add_limbs(this->magnitude, obj.magnitude);
+    else if (sub_limbs(this->magnitude, obj.magnitude))
+        this->signum = -obj.signum;
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt *= BigInt
+    -----------------
+*/
+
+BigInt &BigInt::operator*=(const BigInt &obj)
+{
+    this->assign_product(*this, obj);
+    return *this;
+}
+
+/*
+    BigInt /= BigInt
+    -----------------
+*/
+
+BigInt &BigInt::operator/=(const BigInt &obj)
+{
+    short quotient_sign = this->signum * obj.signum;
+    divide_in_place(this->magnitude, obj.magnitude, false);
+    this->signum = this->magnitude.empty() ? 1 : quotient_sign;
+    return *this;
+}
+
+/*
+    BigInt %= BigInt
+    -----------------
+*/
+
+BigInt &BigInt::operator%=(const BigInt &obj)
+{
+    divide_in_place(this->magnitude, obj.magnitude, true);
+    if (this->magnitude.empty())
+        this->signum = 1;
+    return *this;
+}
+
+/*
+    BigInt += Integer
+    -----------------
+*/
+
+BigInt &BigInt::operator+=(const long long &num)
+{
+    short num_sign = num < 0 ? -1 : 1;
+    limb_t w = integer_magnitude(num);
+
+    if (this->magnitude.empty())
+        this->signum = num_sign;
+
+    if (this->signum == num_sign)
+        add_limb(this->magnitude, w);
+    else if (sub_limb(this->magnitude, w))
+        this->signum = num_sign;
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt -= Integer
+    -----------------
+*/
+
+BigInt &BigInt::operator-=(const long long &num)
+{
+    short num_sign = num < 0 ? 1 : -1; // sign of -num
+    limb_t w = integer_magnitude(num);
+
+    if (this->magnitude.empty())
+        this->signum = num_sign;
+
+    if (this->signum == num_sign)
+        add_limb(this->magnitude, w);
+    else if (sub_limb(this->magnitude, w))
+        this->signum = num_sign;
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt *= Integer
+    -----------------
+*/
+
+BigInt &BigInt::operator*=(const long long &num)
+{
+    mul_limb(this->magnitude, integer_magnitude(num));
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+    else if (num < 0)
+        this->signum = -this->signum;
+
+    return *this;
+}
+
+/*
+    BigInt /= Integer
+    -----------------
+*/
+
+BigInt &BigInt::operator/=(const long long &num)
+{
+    divrem_limb(this->magnitude, integer_magnitude(num));
+
+    if (this->magnitude.empty())
+        this->signum = 1;
+    else if (num < 0)
+        this->signum = -this->signum;
+
+    return *this;
+}
+
+/*
+    BigInt %= Integer
+    -----------------
+*/
+
+BigInt &BigInt::operator%=(const long long &num)
+{
+    *this = *this % num;
+
+    return *this;
+}
+
+/*
+    BigInt += String
+    ----------------
+*/
+
+BigInt &BigInt::operator+=(const std::string &num)
+{
+    *this += BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt -= String
+    ----------------
+*/
+
+BigInt &BigInt::operator-=(const std::string &num)
+{
+    *this -= BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt *= String
+    ----------------
+*/
+
+BigInt &BigInt::operator*=(const std::string &num)
+{
+    *this *= BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt /= String
+    ----------------
+*/
+
+BigInt &BigInt::operator/=(const std::string &num)
+{
+    *this /= BigInt(num);
+
+    return *this;
+}
+
+/*
+    BigInt %= String
+    ----------------
+*/
+
+BigInt &BigInt::operator%=(const std::string &num)
+{
+    *this %= BigInt(num);
+
+    return *this;
+}
+
+
+/*
+    ===========================================================================
+    Bit shift operators
+    ===========================================================================
+    BigInt << n and BigInt >> n multiply and divide by 2^n. >> rounds toward
+    negative infinity, like the shift of a built-in signed integer.
+*/
+
+/*
+    BigInt <<= n
+    ------------
+*/
+
+BigInt &BigInt::operator<<=(size_t bits)
+{
+    if (this->magnitude.empty() || bits == 0)
+        return *this;
+
+    size_t limbs = bits / 64;
+    unsigned shift = bits % 64;
+
+    if (shift)
+    {
+        limb_t out = lshift(this->magnitude.data(), this->magnitude.data(),
+                            this->magnitude.size(), shift);
+        if (out)
+            this->magnitude.push_back(out);
+    }
+
+    if (limbs)
+    {
+        size_t n = this->magnitude.size();
+        this->magnitude.resize(n + limbs);
+        limb_t *p = this->magnitude.data();
+        std::copy_backward(p, p + n, p + n + limbs);
+        std::fill(p, p + limbs, 0);
+    }
+
+    return *this;
+}
+
+/*
+    BigInt >>= n
+    ------------
+*/
+
+BigInt &BigInt::operator>>=(size_t bits)
+{
+    if (this->magnitude.empty() || bits == 0)
+        return *this;
+
+    size_t n = this->magnitude.size();
+    size_t limbs = bits / 64;
+    unsigned shift = bits % 64;
+    limb_t *p = this->magnitude.data();
+
+    // a negative value is rounded down when any 1 bit is shifted out
+    bool round_down = false;
+    if (this->signum == -1)
+    {
+        for (size_t i = 0; i < limbs && i < n && !round_down; i++)
+            round_down = p[i] != 0;
+        if (limbs < n && shift)
+            round_down = round_down || (p[limbs] << (64 - shift)) != 0;
+    }
+
+    if (limbs >= n)
+    {
+        this->magnitude.clear();
+    }
+    else
+    {
+        if (limbs)
+        {
+            std::copy(p + limbs, p + n, p);
+            this->magnitude.resize(n - limbs);
+        }
+        if (shift)
+            rshift(p, p, n - limbs, shift);
+        strip_leading_zeroes(this->magnitude);
+    }
+
+    if (round_down)
+        add_limb(this->magnitude, 1);
+    else if (this->magnitude.empty())
+        this->signum = 1;
+
+    return *this;
+}
+
+/*
+    BigInt << n
+    -----------
+*/
+
+BigInt BigInt::operator<<(size_t bits) const
+{
+    // exactly the limbs of the result, so that one of up to 128 bits stays
+    // inline
+    const Limbs &num = this->magnitude;
+    size_t limbs = num.empty() ? 0 : (num.size() * 64 - __builtin_clzll(num.back()) + bits + 63) / 64;
+    BigInt object(*this, limbs);
+    object <<= bits;
+
+    return object;
+}
+
+/*
+    BigInt >> n
+    -----------
+*/
+
+BigInt BigInt::operator>>(size_t bits) const
+{
+    BigInt object(*this, this->magnitude.size());
+    object >>= bits;
+
+    return object;
+}
+
+
+/*
+    ===========================================================================
+    Relational operators
+    ===========================================================================
+*/
+
+/*
+    BigInt > BigInt
+    ----------------
+*/
+
+bool BigInt::operator>(const BigInt &obj) const
+{
+    if (signum != obj.signum)
+    {
+        return signum > obj.signum;
+    }
+
+    int val = magnitude_compare(this->magnitude, obj.magnitude);
+
+    if (val == 1)
+    {
+        if (signum == -1)
+            return false;
+        else
+            return true;
+    }
+    else if (val == -1)
+    {
+        if (obj.signum == -1)
+            return true;
+        else
+            return false;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/*
+    BigInt < BigInt
+    ----------------
+*/
+
+bool BigInt::operator<(const BigInt &obj) const
+{
+    if (signum != obj.signum)
+    {
+        return signum < obj.signum;
+    }
+
+    int val = magnitude_compare(this->magnitude, obj.magnitude);
+
+    if (val == 1)
+    {
+        if (signum == -1)
+            return true;
+        else
+            return false;
+    }
+    else if (val == -1)
+    {
+        if (obj.signum == -1)
+            return false;
+        else
+            return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/*
+    BigInt == BigInt
+    ----------------
+*/
+
+bool BigInt::operator==(const BigInt &obj) const
+{
+    if (signum != obj.signum)
+    {
+        return false;
+    }
+
+    int val = magnitude_compare(this->magnitude, obj.magnitude);
+
+    if (val == 0)
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/*
+    BigInt >= BigInt
+    ----------------
+*/
+
+bool BigInt::operator>=(const BigInt &obj) const
+{
+    if (*this > obj)
+        return true;
+    else if (*this == obj)
+        return true;
+    else
+        return false;
+}
+
+/*
+    BigInt <= BigInt
+    ----------------
+*/
+
+bool BigInt::operator<=(const BigInt &obj) const
+{
+    if (*this < obj)
+        return true;
+    else if (*this == obj)
+        return true;
+    else
+        return false;
+}
+
+/*
+    BigInt != BigInt
+    ----------------
+*/
+
+bool BigInt::operator!=(const BigInt &obj) const
+{
+    if (*this == obj)
+    {
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+/*
+    BigInt == Integer
+    -----------------
+*/
+
+bool BigInt::operator==(const long long &num) const
+{
+    BigInt temp(num);
+    return *this == temp;
+}
+
+/*
+    Integer == BigInt
+    -----------------
+*/
+
+bool operator==(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) == rhs;
+}
+
+/*
+    BigInt != Integer
+    -----------------
+*/
+
+bool BigInt::operator!=(const long long &num) const
+{
+    BigInt temp(num);
+    return !(*this == temp);
+}
+
+/*
+    Integer != BigInt
+    -----------------
+*/
+
+bool operator!=(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) != rhs;
+}
+
+/*
+    BigInt < Integer
+    ----------------
+*/
+
+bool BigInt::operator<(const long long &num) const
+{
+    BigInt temp(num);
+    return *this < temp;
+}
+
+/*
+    Integer < BigInt
+    ----------------
+*/
+
+bool operator<(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) < rhs;
+}
+
+/*
+    BigInt > Integer
+    ----------------
+*/
+
+bool BigInt::operator>(const long long &num) const
+{
+    BigInt temp(num);
+    return *this > temp;
+}
+
+/*
+    Integer > BigInt
+    ----------------
+*/
+
+bool operator>(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) > rhs;
+}
+
+/*
+    BigInt <= Integer
+    -----------------
+*/
+
+bool BigInt::operator<=(const long long &num) const
+{
+    BigInt temp(num);
+    return !(*this > temp);
+}
+
+/*
+    Integer <= BigInt
+    -----------------
+*/
+
+bool operator<=(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) <= rhs;
+}
+
+/*
+    BigInt >= Integer
+    -----------------
+*/
+
+bool BigInt::operator>=(const long long &num) const
+{
+    BigInt temp(num);
+    return !(*this < temp);
+}
+
+/*
+    Integer >= BigInt
+    -----------------
+*/
+
+bool operator>=(const long long &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) >= rhs;
+}
+
+/*
+    BigInt == String
+    ----------------
+*/
+
+bool BigInt::operator==(const std::string &num) const
+{
+    BigInt temp(num);
+    return *this == temp;
+}
+
+/*
+    String == BigInt
+    ----------------
+*/
+
+bool operator==(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) == rhs;
+}
+
+/*
+    BigInt != String
+    ----------------
+*/
+
+bool BigInt::operator!=(const std::string &num) const
+{
+    BigInt temp(num);
+    return !(*this == temp);
+}
+
+/*
+    String != BigInt
+    ----------------
+*/
+
+bool operator!=(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) != rhs;
+}
+
+/*
+    BigInt < String
+    ---------------
+*/
+
+bool BigInt::operator<(const std::string &num) const
+{
+    BigInt temp(num);
+    return *this < temp;
+}
+
+/*
+    String < BigInt
+    ---------------
+*/
+
+bool operator<(const std::string &lhs, const BigInt &rhs)
+{
+    return BigInt(lhs) < rhs;
+}
+
+/*
+    BigInt > String
+    ---------------
+*/
+
+bool BigInt::operator>(const std::string &num) const
+{
+    BigInt temp(num);
+    return *this > temp;
 }
 
 /*
-    Logical or
-    -----------
-    BigInt || BigInt
+    String > BigInt
+    ---------------
 */
 
-bool BigInt::operator||(BigInt &obj)
+bool operator>(const std::string &lhs, const BigInt &rhs)
 {
-    BigInt zero("0");
-    return (zero != *this) || (zero != obj);
+    return BigInt(lhs) > rhs;
 }
 
 /*
-    Logical not
-    -----------
-    !BigInt
+    BigInt <= String
+    ----------------
 */
 
-bool BigInt::operator!()
+bool BigInt::operator<=(const std::string &num) const
 {
-    BigInt zero("0");
-    return !(zero != *this);
+    BigInt temp(num);
+    return !(*this > temp);
 }
 
-// Pre-increment
-BigInt BigInt::operator++()
-{
-    BigInt one("1");
-    *this = *this + one;
-    return *this;
-}
-// Post-increment
-BigInt BigInt::operator++(int)
-{
-    BigInt temp = *this;
-    ++*this;
-    return temp;
-}
-// Pre-decrement
-BigInt BigInt::operator--()
-{
-    BigInt one("1");
-    *this = *this - one;
-    return *this;
-}
-// Post-decrement
-BigInt BigInt::operator--(int)
+/*
+    String <= BigInt
+    ----------------
+*/
+
+bool operator<=(const std::string &lhs, const BigInt &rhs)
 {
-    BigInt temp = *this;
-    --*this;
-    return temp;
+    return BigInt(lhs) <= rhs;
 }
 
-
 /*
-    istream operator overlaod
-    -------------------------
-    example: cin >> bigInt
+    BigInt >= String
+    ----------------
 */
 
-std::istream &operator>>(std::istream &input, BigInt &obj)
+bool BigInt::operator>=(const std::string &num) const
 {
-    std::string inputNum;
-
-    input >> inputNum;
-
-    if (inputNum.empty())
-    {
-        obj.bigInteger = "0";
-        obj.sign = 1;
-        return input;
-    }
-
-    obj = inputNum;
-
-    return input;
+    BigInt temp(num);
+    return !(*this < temp);
 }
 
 /*
-    ostream operator overlaod
-    -------------------------
-    example: std::cout << bigInt
+    String >= BigInt
+    ----------------
 */
 
-std::ostream &operator<<(std::ostream &output, const BigInt &obj)
+bool operator>=(const std::string &lhs, const BigInt &rhs)
 {
-    if (obj.sign == -1)
-        std::cout << "-";
-
-    output << obj.bigInteger;
+    return BigInt(lhs) >= rhs;
+}
 
-    return output;
+BigInt::~BigInt()
+{
 }
 
+
 /*
     ===========================================================================
-    Constructors
+    Greatest common divisor
     ===========================================================================
+    The GCD functions reduce a pair (a, b) of non negative integers with
+    2x2 matrices M of non negative entries and determinant 1, which relate
+    it to the reduced pair by (a; b) = M (alpha; beta). Then gcd(a, b) =
+    gcd(alpha, beta), and the first row of M gives the Bezout cofactor of b.
+    A reduction step takes a multiple of the smaller number from the larger:
+
+      - Lehmer's algorithm finds many steps at once from the top 128 bits of
+        the pair, and applies them in one pass over the limbs
+      - Above HGCD_THRESHOLD limbs, a half-GCD finds the matrix that halves
+        the pair from its top half, recursively, so the whole GCD runs at
+        the speed of the multiplication
+      - Single limbs use binary GCD
+
+    HGCD_THRESHOLD is in limbs and can be tuned like the multiplication
+    thresholds.
 */
 
+size_t HGCD_THRESHOLD = 40;
+
 /*
-    Default constructor
-    -------------------
+    bit_length / top_bits
+    ---------------------
+    The number of bits of |x|, and the bits k to k+127 of |x|.
 */
 
-BigInt::BigInt()
+size_t bit_length(const BigInt &x)
+{
+    const Limbs &a = x.magnitude;
+    return a.empty() ? 0 : a.size() * 64 - __builtin_clzll(a[a.size() - 1]);
+}
+
+dlimb_t top_bits(const BigInt &x, size_t k)
 {
-    bigInteger = "0";
-    sign = 1;
+    const Limbs &a = x.magnitude;
+    size_t i = k / 64;
+    unsigned shift = k % 64;
+    limb_t w[3];
+    for (size_t j = 0; j < 3; j++)
+        w[j] = i + j < a.size() ? a[i + j] : 0;
+
+    dlimb_t low = w[0] | (dlimb_t)w[1] << 64;
+    if (shift == 0)
+        return low;
+    return (low >> shift) | (dlimb_t)w[2] << (128 - shift);
 }
 
 /*
-    Copy constructor
-    ----------------
+    gcd_1 / gcd_2
+    -------------
+    Binary GCD of single limbs, and Euclid's algorithm down to them for two
+    limbs.
 */
 
-BigInt::BigInt(const BigInt &num)
+limb_t gcd_1(limb_t a, limb_t b)
+{
+    if (a == 0 || b == 0)
+        return a | b;
+
+    unsigned shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b)
+    {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+            std::swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+dlimb_t gcd_2(dlimb_t a, dlimb_t b)
 {
-    bigInteger = num.bigInteger;
-    sign = num.sign;
+    while (a >> 64 || b >> 64)
+    {
+        if (a < b)
+            std::swap(a, b);
+        if (b == 0)
+            return a;
+        a %= b;
+    }
+    return gcd_1((limb_t)a, (limb_t)b);
 }
 
 /*
-    String to BigInt
-    ----------------
+    GcdMatrix
+    ---------
+    A reduction matrix M. When only the first row is wanted (full is
+    false), the second row is not kept up to date.
 */
 
-BigInt::BigInt(const std::string &num)
+struct GcdMatrix
 {
-    if(num[0] == '+' or num[0] == '-')// check for sign
-    {   
-        std::string magnitude = num.substr(1);
-        if(is_valid_number(magnitude))
+    BigInt m00, m01, m10, m11;
+    bool full;
+
+    explicit GcdMatrix(bool full_matrix = true) : m00(1), m01(0), m10(0), m11(1), full(full_matrix) {}
+
+    // M = M N
+    void mul(const GcdMatrix &N)
+    {
+        BigInt t = m00 * N.m01 + m01 * N.m11;
+        m00 = m00 * N.m00 + m01 * N.m10;
+        m01 = std::move(t);
+        if (full)
         {
-            bigInteger = magnitude;
-            sign = (num[0] == '+') ? 1 : -1;
+            t = m10 * N.m01 + m11 * N.m11;
+            m10 = m10 * N.m00 + m11 * N.m10;
+            m11 = std::move(t);
         }
-        else
+    }
+
+    // M = M N for the matrix of a Lehmer step, with entries below 2^63
+    void mul(const limb_t (&n)[4])
+    {
+        BigInt t = m00 * (long long)n[1] + m01 * (long long)n[3];
+        m00 = m00 * (long long)n[0] + m01 * (long long)n[2];
+        m01 = std::move(t);
+        if (full)
         {
-            throw std::invalid_argument("Expected an integer, got \'" + num + "\'");
-        }        
+            t = m10 * (long long)n[1] + m11 * (long long)n[3];
+            m10 = m10 * (long long)n[0] + m11 * (long long)n[2];
+            m11 = std::move(t);
+        }
     }
-    else// if no sign is specified
+
+    // M = M (1 q; 0 1) after a -= q b, or M = M (1 0; q 1) after b -= q a
+    void mul_step(bool reduced_a, const BigInt &q)
     {
-        if(is_valid_number(num))
+        if (reduced_a)
         {
-            bigInteger = num;
-            sign = 1; // positive by default
+            m01 += q * m00;
+            if (full)
+                m11 += q * m10;
         }
         else
         {
-            throw std::invalid_argument("Expected an integer, got \'" + num + "\'");
+            m00 += q * m01;
+            if (full)
+                m10 += q * m11;
         }
-        
     }
+};
 
-    strip_leading_zeroes(bigInteger);
+/*
+    gcd_lehmer_apply
+    ----------------
+    (a; b) = (n11 a - n01 b; n00 b - n10 a), both known to be non negative.
+*/
 
-    if(sign == -1 && bigInteger == "0")
-        sign = 1;
+void gcd_lehmer_apply(BigInt &a, BigInt &b, const limb_t (&N)[4])
+{
+    size_t n = std::max(a.magnitude.size(), b.magnitude.size());
+    auto combine = [n](const Limbs &u, limb_t cu, const Limbs &v, limb_t cv) {
+        Limbs r(n + 1);
+        r[u.size()] = mul_1(r.data(), u.data(), u.size(), cu);
+        limb_t borrow = submul_1(r.data(), v.data(), v.size(), cv);
+        sub_1(r.data() + v.size(), r.data() + v.size(), n + 1 - v.size(), borrow);
+        strip_leading_zeroes(r);
+        return r;
+    };
+
+    Limbs x = combine(a.magnitude, N[3], b.magnitude, N[1]);
+    b.magnitude = combine(b.magnitude, N[0], a.magnitude, N[2]);
+    a.magnitude = std::move(x);
 }
 
 /*
-    Integer to BigInt
-    -----------------
+    gcd_lehmer
+    ----------
+    A Lehmer step: Euclid's algorithm on the top 128 bits of (a, b), taking
+    only steps that keep both numbers at least 2^s (or, for s = 0, above
+    zero), applied to a and b at once. Returns false when it finds no step.
 */
-BigInt::BigInt(const long long &ll)
+
+bool gcd_lehmer(BigInt &a, BigInt &b, size_t s, GcdMatrix *M)
 {
-    bigInteger = std::to_string(ll);
-    if(ll < 0)
+    /**
+     * Algorithm of gcd_lehmer function
+     *      1. Take ah and bh, the bits k and up of a and b, with ah or bh
+     *         of 128 bits
+     *      2. Run Euclid's algorithm on them with the matrix N of its
+     *         steps, but only take a step if it leaves the reduced value
+     *         at least guard = 2^65 + 2^(s-k). The entries of N stay below
+     *         2^128 / guard <= 2^63
+     *      3. The true alpha = n11 a - n01 b is 2^k (n11 ah - n01 bh) plus
+     *         an error below 2^(k+63), so it is at least 2^s (or 1 when s
+     *         is 0): N is a valid reduction of the full numbers. Apply it
+     *         with one multiply and one multiply-subtract pass per number
+     */
+
+    size_t n = std::max(bit_length(a), bit_length(b));
+    if (n <= 128)
+        return false;
+    size_t k = n - 128;
+    if (s > k + 126)
+        return false;
+
+    dlimb_t guard = (dlimb_t)1 << 65;
+    if (s > k)
+        guard += (dlimb_t)1 << (s - k);
+
+    dlimb_t ah = top_bits(a, k), bh = top_bits(b, k);
+    limb_t N[4] = {1, 0, 0, 1};
+    bool progress = false;
+    for (;;)
     {
-        sign = -1;
-        bigInteger = bigInteger.substr(1);
+        if (ah >= bh)
+        {
+            if (bh < guard || ah - guard < bh)
+                break;
+            dlimb_t r = ah - guard;
+            limb_t q = (r - bh < bh) ? 1 : (limb_t)(r / bh);
+            ah -= (dlimb_t)q * bh;
+            N[1] += q * N[0];
+            N[3] += q * N[2];
+        }
+        else
+        {
+            if (ah < guard || bh - guard < ah)
+                break;
+            dlimb_t r = bh - guard;
+            limb_t q = (r - ah < ah) ? 1 : (limb_t)(r / ah);
+            bh -= (dlimb_t)q * ah;
+            N[0] += q * N[1];
+            N[2] += q * N[3];
+        }
+        progress = true;
     }
-    else
-        sign = 1;
-}
-
-/*
-    ===========================================================================
-    Assignment operators
-    ===========================================================================
-*/
+    if (!progress)
+        return false;
 
+    gcd_lehmer_apply(a, b, N);
+    if (M)
+        M->mul(N);
+    return true;
+}
 
 /*
-    BigInt = BigInt
-    ---------------
+    gcd_step
+    --------
+    One step at full precision: take from the larger of a, b the largest
+    multiple of the smaller that leaves it at least G. Returns false when
+    there is none.
 */
 
-BigInt& BigInt::operator=(const BigInt &num)
+bool gcd_step(BigInt &a, BigInt &b, const BigInt &G, GcdMatrix *M)
 {
-    bigInteger = num.bigInteger;
-    sign = num.sign;
+    bool reduce_a = a >= b;
+    BigInt &x = reduce_a ? a : b;
+    const BigInt &y = reduce_a ? b : a;
+    if (y.is_zero() || y < G)
+        return false;
 
-    return *this;
+    // Two limbs and no matrix: finish natively
+    if (!M && G.is_zero() && x.magnitude.size() <= 2)
+    {
+        const Limbs &u = x.magnitude, &v = y.magnitude;
+        dlimb_t g = gcd_2(u[0] | (u.size() > 1 ? (dlimb_t)u[1] << 64 : 0),
+                          v[0] | (v.size() > 1 ? (dlimb_t)v[1] << 64 : 0));
+        Limbs r(2);
+        r[0] = (limb_t)g;
+        r[1] = (limb_t)(g >> 64);
+        strip_leading_zeroes(r);
+        a.magnitude = std::move(r);
+        b = BigInt();
+        return true;
+    }
+
+    BigInt q = (x - G) / y;
+    if (q.is_zero())
+        return false;
+    x -= q * y;
+    if (M)
+        M->mul_step(reduce_a, q);
+    return true;
 }
 
 /*
-    BigInt = Integer
-    ----------------
+    gcd_reduce
+    ----------
+    Reduces (a, b), both non negative, with steps that keep both at least
+    2^s, or with Euclid's steps until one of them is zero when s = 0.
+    Multiplies M (if not null) by the matrix of the steps. Returns whether
+    it took any step.
 */
 
-BigInt& BigInt::operator=(const long long &num)
+bool gcd_reduce(BigInt &a, BigInt &b, size_t s, GcdMatrix *M)
 {
-    BigInt temp(num);
-    bigInteger = temp.bigInteger;
-    sign = temp.sign;
+    /**
+     * Complexity of gcd_reduce function
+     *
+     * Time complexity : O(M(n) log n) for n limbs, where M(n) is the time
+     *                   of an n limb product, and O(n^2) below
+     *                   HGCD_THRESHOLD
+     * Space complexity: O(n)
+     *
+     * Algorithm of gcd_reduce function
+     *      1. While the numbers have more than HGCD_THRESHOLD limbs above
+     *         2^s, reduce their top n - p bits recursively with
+     *         s' = (n - p) / 2 + 1, and apply that matrix to the full
+     *         numbers. The error from the low p bits keeps the result at
+     *         least 2^(p + s' - 1) (the same argument as for a Lehmer
+     *         step), which is 2^s or more for p >= 2s - n. p = n / 2 gives
+     *         a half size problem
+     *      2. Then take Lehmer steps, and single steps at full precision
+     *         when a Lehmer step finds none
+     */
 
-    return *this;
+    BigInt G;
+    if (s)
+        G = bigint_constant(1) << s;
+
+    bool progress = false;
+    for (;;)
+    {
+        size_t n = std::max(bit_length(a), bit_length(b));
+        if (s && n > s + 64 * HGCD_THRESHOLD)
+        {
+            size_t p = std::max(n / 2, 2 * s > n ? 2 * s - n : 0);
+            BigInt A = a >> p, B = b >> p;
+            GcdMatrix N;
+            if (gcd_reduce(A, B, (n - p) / 2 + 1, &N))
+            {
+                BigInt x = N.m11 * a - N.m01 * b, y = N.m00 * b - N.m10 * a;
+                if (x >= G && y >= G)
+                {
+                    a = std::move(x);
+                    b = std::move(y);
+                    if (M)
+                        M->mul(N);
+                    progress = true;
+                    continue;
+                }
+            }
+        }
+
+        if (!gcd_lehmer(a, b, s, M) && !gcd_step(a, b, G, M))
+            return progress;
+        progress = true;
+    }
 }
 
 /*
-    BigInt = String
-    ---------------
+    gcd_core
+    --------
+    Reduces (a, b), both non negative, until one of them is zero, so that
+    the other one is the GCD, and multiplies M (if not null) by the matrix
+    of the steps.
 */
 
-BigInt& BigInt::operator=(const std::string &num)
+void gcd_core(BigInt &a, BigInt &b, GcdMatrix *M)
 {
-    BigInt temp(num);
-    bigInteger = temp.bigInteger;
-    sign = temp.sign;
-
-    return *this;
+    // Halve large numbers with the half-GCD, then cross below 2^s with a
+    // full division
+    for (;;)
+    {
+        size_t n = std::max(bit_length(a), bit_length(b));
+        if (n <= 64 * HGCD_THRESHOLD)
+            break;
+        gcd_reduce(a, b, n / 2 + 1, M);
+        if (!gcd_step(a, b, BigInt(), M))
+            return;
+    }
+    gcd_reduce(a, b, 0, M);
 }
 
-
 /*
-    ===========================================================================
-    Unary arithmetic operators
-    ===========================================================================
+    gcd
+    ---
+    The greatest common divisor of |a| and |b|, where gcd(0, 0) = 0.
 */
 
+BigInt gcd(const BigInt &a, const BigInt &b)
+{
+    BigInt u = a.sign() < 0 ? -a : a, v = b.sign() < 0 ? -b : b;
+    gcd_core(u, v, nullptr);
+    return u.is_zero() ? v : u;
+}
+
 /*
-    +BigInt
-    -------
-    Returns the value of a BigInt.
+    lcm
+    ---
+    The least common multiple of |a| and |b|, where lcm(0, b) = 0.
 */
 
-BigInt BigInt::operator+() const
+BigInt lcm(const BigInt &a, const BigInt &b)
 {
-    return *this;
+    if (a.is_zero() || b.is_zero())
+        return BigInt();
+
+    BigInt result = a / gcd(a, b) * b;
+    return result.sign() < 0 ? -result : result;
 }
 
 /*
-    -BigInt
-    -------
-    Returns the negative of a BigInt.
+    gcdext
+    ------
+    Returns g = gcd(a, b) and sets x and y to Bezout coefficients, with
+    a x + b y = g and |y| <= |a| / (2g). gcdext(a, 0) gives x = sign(a) and
+    y = 0.
 */
 
-BigInt BigInt::operator-() const
+BigInt gcdext(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y)
 {
-    BigInt temp;
+    /**
+     * Algorithm of gcdext function
+     *      1. Reduce (|a|, |b|) to (g, 0) or (0, g) with gcd_core, keeping
+     *         the first row of the matrix M. Its inverse gives g as
+     *         m11 |a| - m01 |b| or m00 |b| - m10 |a|, so the coefficient
+     *         of |b| is -m01 or m00
+     *      2. Bring it into (-|a| / 2g, |a| / 2g] by the period |a| / g,
+     *         and solve for the other coefficient with an exact division
+     */
 
-    temp.bigInteger = bigInteger;
-    if(bigInteger != "0")
+    BigInt A = a.sign() < 0 ? -a : a, B = b.sign() < 0 ? -b : b;
+    if (B.is_zero() || A.is_zero())
     {
-        if(sign == 1)
-            temp.sign = -1;
-        else
-            temp.sign = 1;
+        x = B.is_zero() ? BigInt(a.sign()) : BigInt();
+        y = B.is_zero() ? BigInt() : BigInt(b.sign());
+        return B.is_zero() ? A : B;
     }
 
-    return temp;
+    BigInt u = A, v = B;
+    GcdMatrix M(false);
+    gcd_core(u, v, &M);
+    BigInt g = u.is_zero() ? v : u;
+    BigInt t = u.is_zero() ? M.m00 : -M.m01;
+
+    BigInt period = A / g;
+    t %= period;
+    if (t.sign() < 0)
+        t += period;
+    if (t + t > period)
+        t -= period;
+
+    x = (g - t * B) / A;
+    y = std::move(t);
+    if (a.sign() < 0)
+        x = -x;
+    if (b.sign() < 0)
+        y = -y;
+    return g;
 }
 
+/*
+    invmod
+    ------
+    The x in [0, |m|) with a x = 1 mod m. Throws std::domain_error when a
+    and m aren't coprime.
+*/
+
+BigInt invmod(const BigInt &a, const BigInt &m)
+{
+    if (m.is_zero())
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
 
+    BigInt M = m.sign() < 0 ? -m : m;
+    BigInt r = a % M;
+    if (r.sign() < 0)
+        r += M;
+    if (M.is_one())
+        return BigInt();
+
+    // (M; r) = G (u; v), and the inverse is the coefficient of r
+    BigInt u = M, v = r;
+    GcdMatrix G(false);
+    gcd_core(u, v, &G);
+    if (!(u.is_zero() ? v : u).is_one())
+        throw std::domain_error("invmod: not invertible");
+
+    BigInt inverse = (u.is_zero() ? G.m00 : -G.m01) % M;
+    if (inverse.sign() < 0)
+        inverse += M;
+    return inverse;
+}
 
 
 /*
     ===========================================================================
-    Binary arithmetic operators
+    Modular contexts
     ===========================================================================
 */
 
 /*
-    BigInt + BigInt
-    ---------------
+    ModContext
+    ----------
+    Precomputed reduction constants for one modulus: the Barrett reciprocal,
+    and the Montgomery constants when the modulus is odd. None of the
+    operations divide. All results are in [0, |modulus|), and arguments
+    outside that range are reduced first.
+
+    A context can be shared: its operations are const and thread safe, and
+    its storage always comes from new[], so it may outlive the arena that
+    was current when it was built.
+
+    The free powmod keeps the contexts of the last POWMOD_CACHE_SIZE moduli
+    it was called with in a per thread cache, so calling it in a loop with
+    one modulus builds the constants once.
 */
 
-BigInt BigInt::operator+(BigInt obj)
-{
-    BigInt object;
+const size_t POWMOD_CACHE_SIZE = 4;
 
-    if (this->sign == obj.sign)
-    {
-        std::string result = addition(this->bigInteger, obj.bigInteger);
-        // Create a new return type object by given result string
-        object.bigInteger = result;
-        if (sign == 1)
-            object.sign = 1;
-        else
-            object.sign = -1;
-    }
-    else
-    {
-        std::string result = subtraction(this->bigInteger, obj.bigInteger);
-        // Create a new return type object by given result string
-        object.bigInteger = result;
+template <class Modulus>
+class ModInt;
 
-        int val = string_compare(this->bigInteger, obj.bigInteger);
+class ModContext
+{
+public:
+    explicit ModContext(const BigInt &modulus);
 
-        if (val == 1)
-        {
-            object.sign = this->sign;
-        }
-        else if (val == -1)
-        {
-            object.sign = obj.sign;
-        }
-        else
-        {
-            object.sign = 1;
-        }
-    }
+    const BigInt &modulus() const { return mod; }
 
-    if (object.bigInteger == "0")
-        object.sign = 1;
+    BigInt reduce(const BigInt &x) const;
+    BigInt addmod(const BigInt &a, const BigInt &b) const;
+    BigInt submod(const BigInt &a, const BigInt &b) const;
+    BigInt mulmod(const BigInt &a, const BigInt &b) const;
+    BigInt sqrmod(const BigInt &a) const;
+    BigInt powmod(const BigInt &base, const BigInt &exponent) const;
+    // Throws std::domain_error when a and the modulus aren't coprime
+    BigInt invmod(const BigInt &a) const;
 
-    return object;
-}
+private:
+    template <class Modulus>
+    friend class ModInt;
+    friend BigInt powmod(const BigInt &, const BigInt &, const BigInt &);
+
+    BigInt mod;
+    Barrett barrett;       // empty in a context that only exponentiates
+    Montgomery montgomery; // empty when the modulus is even
+
+    // with_barrett = false skips the Barrett reciprocal when the modulus is
+    // odd, for a context that is only used by powmod
+    ModContext(const BigInt &modulus, bool with_barrett);
+    static const ModContext &cached(const BigInt &modulus);
+
+    bool reduced(const BigInt &x) const;
+    BigInt reduce_product(const BigInt &a, const BigInt &b) const;
+
+    // Residues of n limbs in the form used between operations: Montgomery
+    // form when the modulus is odd, and as they are otherwise.
+    size_t limbs() const { return mod.magnitude.size(); }
+    const limb_t *modulus_limbs() const { return mod.magnitude.data(); }
+    Limbs to_form(const BigInt &x) const;
+    BigInt from_form(const Limbs &a) const;
+    void form_mul(limb_t *r, const limb_t *a, const limb_t *b) const;
+    void form_sqr(limb_t *r, const limb_t *a) const;
+    void form_pow(limb_t *r, const limb_t *g, const BigInt &exponent) const;
+};
 
 /*
-    BigInt - BigInt
-    ---------------
+    Constructor
+    -----------
 */
 
-BigInt BigInt::operator-(BigInt obj)
-{
-    // sign changed
-    obj.sign *= -1;
-
-    BigInt object;
+ModContext::ModContext(const BigInt &modulus) : ModContext(modulus, true) {}
 
-    if (this->sign == obj.sign)
+ModContext::ModContext(const BigInt &modulus, bool with_barrett)
+{
+    if (modulus.magnitude.empty())
     {
-        std::string result = addition(this->bigInteger, obj.bigInteger);
-        // Create a new return type object by given result string
-        object.bigInteger = result;
-        if (sign == 1)
-            object.sign = 1;
-        else
-            object.sign = -1;
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
     }
-    else
-    {
-        std::string result = subtraction(this->bigInteger, obj.bigInteger);
-        // Create a new return type object by given result string
-        object.bigInteger = result;
 
-        int val = string_compare(this->bigInteger, obj.bigInteger);
+    BigIntAllocatorScope scope(nullptr);
+    mod = BigInt(modulus, modulus.magnitude.size());
+    mod.signum = 1;
+
+    const Limbs &m = mod.magnitude;
+    if (with_barrett || !(m[0] & 1))
+        barrett = Barrett(m.data(), m.size());
+    if (m[0] & 1)
+        montgomery = Montgomery(m.data(), m.size());
+}
+
+/*
+    cached
+    ------
+    The context of |modulus| from the cache of this thread, most recently
+    used first, building it when it isn't there.
+*/
+
+const ModContext &ModContext::cached(const BigInt &modulus)
+{
+    static thread_local std::vector<ModContext> cache;
 
-        if (val == 1)
-        {
-            object.sign = this->sign;
-        }
-        else if (val == -1)
-        {
-            object.sign = obj.sign;
-        }
-        else
+    for (size_t i = 0; i < cache.size(); i++)
+    {
+        if (magnitude_compare(cache[i].mod.magnitude, modulus.magnitude) == 0)
         {
-            object.sign = 1;
+            std::rotate(cache.begin(), cache.begin() + i, cache.begin() + i + 1);
+            return cache[0];
         }
     }
 
-    if (object.bigInteger == "0")
-        object.sign = 1;
+    ModContext context(modulus, false);
+    if (cache.size() == POWMOD_CACHE_SIZE)
+        cache.pop_back();
+    cache.insert(cache.begin(), std::move(context));
+    return cache[0];
+}
 
-    return object;
+/*
+    reduced
+    -------
+    Whether x is already in [0, modulus).
+*/
+
+bool ModContext::reduced(const BigInt &x) const
+{
+    return x.signum == 1 && magnitude_compare(x.magnitude, mod.magnitude) < 0;
 }
 
 /*
-    BigInt - BigInt
-    ---------------
+    reduce
+    ------
+    x mod modulus, in [0, modulus) also for a negative x.
 */
 
-BigInt BigInt::operator*(BigInt obj)
+BigInt ModContext::reduce(const BigInt &x) const
 {
-    std::string result = multiplication(this->bigInteger, obj.bigInteger);
+    /**
+     * Complexity of reduce function
+     *
+     * Time complexity : O(k * M(n)) for an x of k * n limbs, where M(n) is
+     *                   the time of an n limb product
+     * Space complexity: O(n)
+     *
+     * Algorithm of reduce function
+     *      1. A Barrett reduction takes up to 2n limbs, so reduce the top
+     *         2n limbs of |x| first
+     *      2. Then bring the limbs below in, n at a time, under the
+     *         remainder so far, and reduce again
+     *      3. For a negative x, subtract the remainder from the modulus
+     */
 
-    BigInt object;
+    if (reduced(x))
+        return x;
+    if (!barrett.n)
+    {
+        BigInt r = x % mod;
+        if (r.signum == -1 && !r.magnitude.empty())
+            r += mod;
+        return r;
+    }
+
+    size_t n = barrett.n, an = x.magnitude.size();
+    const limb_t *a = x.magnitude.data();
+    Limbs window = scratch_limbs(2 * n), t = scratch_limbs(barrett.scratch_size);
+    Limbs r(n);
 
-    object.bigInteger = result;
+    size_t low = an > 2 * n ? an - 2 * n : 0;
+    std::copy(a + low, a + an, window.data());
+    barrett.reduce(r.data(), window.data(), t.data());
 
-    if (result == "0")
+    while (low > 0)
     {
-        // object.bigInteger = "0";
-        object.sign = 1;
+        size_t step = std::min(n, low);
+        low -= step;
+        std::copy(a + low, a + low + step, window.data());
+        std::copy(r.begin(), r.end(), window.data() + step);
+        std::fill(window.data() + step + n, window.data() + 2 * n, 0);
+        barrett.reduce(r.data(), window.data(), t.data());
     }
-    else
+
+    strip_leading_zeroes(r);
+    if (x.signum == -1 && !r.empty())
     {
-        object.sign = this->sign * obj.sign;
+        Limbs positive(n);
+        sub(positive.data(), mod.magnitude.data(), n, r.data(), r.size());
+        strip_leading_zeroes(positive);
+        r = std::move(positive);
     }
 
-    return object;
+    BigInt result;
+    result.magnitude = std::move(r);
+    return result;
 }
 
 /*
-    BigInt / BigInt
+    addmod / submod
     ---------------
+    (a + b) mod modulus and (a - b) mod modulus, which needs at most one
+    correction by the modulus once a and b are reduced.
 */
 
-BigInt BigInt::operator/(BigInt obj)
+BigInt ModContext::addmod(const BigInt &a, const BigInt &b) const
 {
-    std::string resultString = division(this->bigInteger, obj.bigInteger);
-    BigInt resultObject;
-
-    resultObject.bigInteger = resultString;
-
-    if (resultString == "0")
-        resultObject.sign = 1;
-    else
-        resultObject.sign = this->sign * obj.sign;
+    BigInt ra, rb;
+    const BigInt &x = reduced(a) ? a : (ra = reduce(a));
+    const BigInt &y = reduced(b) ? b : (rb = reduce(b));
+
+    BigInt sum = x + y;
+    if (magnitude_compare(sum.magnitude, mod.magnitude) >= 0)
+        sum -= mod;
+    return sum;
+}
 
-    return resultObject;
+BigInt ModContext::submod(const BigInt &a, const BigInt &b) const
+{
+    BigInt ra, rb;
+    const BigInt &x = reduced(a) ? a : (ra = reduce(a));
+    const BigInt &y = reduced(b) ? b : (rb = reduce(b));
+
+    BigInt difference = x - y;
+    if (difference.signum == -1 && !difference.magnitude.empty())
+        difference += mod;
+    return difference;
 }
 
 /*
-    BigInt % BigInt
-    ---------------
+    reduce_product
+    --------------
+    a * b mod modulus for reduced a and b, with a single Barrett reduction
+    of the product.
 */
 
-BigInt BigInt::operator%(BigInt obj)
+BigInt ModContext::reduce_product(const BigInt &a, const BigInt &b) const
 {
-    std::string resultString = remainder(this->bigInteger, obj.bigInteger);
-    BigInt resultObject;
-
-    resultObject.bigInteger = resultString;
-
-    if (resultString == "0")
-        resultObject.sign = 1;
+    if (a.magnitude.empty() || b.magnitude.empty())
+        return BigInt();
+    if (!barrett.n)
+        return a * b % mod;
+
+    size_t n = barrett.n;
+    const Limbs &x = a.magnitude, &y = b.magnitude;
+    Limbs product = scratch_limbs(2 * n), t = scratch_limbs(barrett.scratch_size);
+    std::fill(product.data() + x.size() + y.size(), product.data() + 2 * n, 0);
+    if (&a == &b)
+        sqr(product.data(), x.data(), x.size());
+    else if (x.size() >= y.size())
+        mul(product.data(), x.data(), x.size(), y.data(), y.size());
     else
-        resultObject.sign = this->sign;
+        mul(product.data(), y.data(), y.size(), x.data(), x.size());
 
-    return resultObject;
-}
+    Limbs r(n);
+    barrett.reduce(r.data(), product.data(), t.data());
+    strip_leading_zeroes(r);
 
+    BigInt result;
+    result.magnitude = std::move(r);
+    return result;
+}
 
 /*
-    BigInt + Integer
-    ----------------
+    mulmod / sqrmod
+    ---------------
+    a * b mod modulus and a^2 mod modulus.
 */
 
-BigInt BigInt::operator+(const long long &num)
+BigInt ModContext::mulmod(const BigInt &a, const BigInt &b) const
 {
-    return *this + BigInt(num);
+    BigInt ra, rb;
+    const BigInt &x = reduced(a) ? a : (ra = reduce(a));
+    const BigInt &y = reduced(b) ? b : (rb = reduce(b));
+    return reduce_product(x, y);
 }
 
-/*
-    Integer + BigInt
-    ----------------
-*/
-
-BigInt operator+(const long long &lhs, const BigInt &rhs)
+BigInt ModContext::sqrmod(const BigInt &a) const
 {
-    return BigInt(lhs) + rhs;
+    BigInt ra;
+    const BigInt &x = reduced(a) ? a : (ra = reduce(a));
+    return reduce_product(x, x);
 }
 
 /*
-    BigInt - Integer
-    ----------------
+    powmod
+    ------
+    base^exponent mod modulus, for an exponent that isn't negative.
 */
 
-BigInt BigInt::operator-(const long long &num)
+BigInt ModContext::powmod(const BigInt &base, const BigInt &exponent) const
 {
-    return *this - BigInt(num);
+    /**
+     * Complexity of powmod function
+     *
+     * Time complexity : O(k * M(n)) for a k bit exponent and an n limb
+     *                   modulus, where M(n) is the time of an n limb product
+     * Space complexity: O(n)
+     *
+     * Algorithm of powmod function
+     *      1. Reduce the base
+     *      2. For an odd modulus, convert the base to Montgomery form, so
+     *         that every modular product is a product (or a square, which
+     *         is cheaper) and a REDC pass
+     *      3. For an even modulus, reduce every product with Barrett
+     *      4. Either way, exponentiate with powmod_window, which spends
+     *         one squaring per bit of the exponent and a product for
+     *         every window of up to 6 bits
+     */
+
+    if (exponent.signum == -1 && !exponent.magnitude.empty())
+        throw std::domain_error("powmod: negative exponent");
+
+    const Limbs &m = mod.magnitude;
+    if (m.size() == 1 && m[0] == 1)
+        return BigInt();
+    if (exponent.magnitude.empty())
+        return bigint_constant(1);
+
+    BigInt b = reduce(base);
+    if (b.magnitude.empty())
+        return BigInt();
+
+    Limbs g = to_form(b), x(m.size());
+    form_pow(x.data(), g.data(), exponent);
+    return from_form(x);
 }
 
 /*
-    Integer - BigInt
-    ----------------
+    invmod
+    ------
+    The x in [0, modulus) with a * x = 1 mod modulus.
 */
 
-BigInt operator-(const long long &lhs, const BigInt &rhs)
+BigInt ModContext::invmod(const BigInt &a) const
 {
-    return BigInt(lhs) - rhs;
+    return ::invmod(a, mod);
 }
 
 /*
-    BigInt * Integer
-    ----------------
+    to_form / from_form
+    -------------------
+    x reduced into a residue of n limbs in the internal form, and back.
 */
 
-BigInt BigInt::operator*(const long long &num)
+Limbs ModContext::to_form(const BigInt &x) const
 {
-    return *this * BigInt(num);
+    Limbs r(limbs());
+    BigInt y = reduce(x);
+    std::copy(y.magnitude.begin(), y.magnitude.end(), r.data());
+    if (montgomery.n)
+        with_scratch(montgomery.scratch_size, [&](limb_t *t) { montgomery.to_form(r.data(), r.data(), t); });
+    return r;
 }
 
-/*
-    Integer * BigInt
-    ----------------
-*/
-
-BigInt operator*(const long long &lhs, const BigInt &rhs)
+BigInt ModContext::from_form(const Limbs &a) const
 {
-    return BigInt(lhs) * rhs;
+    Limbs r(limbs());
+    if (montgomery.n)
+        with_scratch(montgomery.scratch_size, [&](limb_t *t) { montgomery.from_form(r.data(), a.data(), t); });
+    else
+        std::copy(a.begin(), a.end(), r.data());
+
+    BigInt result;
+    strip_leading_zeroes(r);
+    result.magnitude = std::move(r);
+    return result;
 }
 
 /*
-    BigInt / Integer
-    ----------------
+    form_mul / form_sqr / form_pow
+    ------------------------------
+    Products and powers of residues in the internal form. r may alias a or
+    b, but not g.
 */
 
-BigInt BigInt::operator/(const long long &num)
+void ModContext::form_mul(limb_t *r, const limb_t *a, const limb_t *b) const
 {
-    return *this / BigInt(num);
+    if (montgomery.n)
+        with_scratch(montgomery.scratch_size, [&](limb_t *t) { montgomery.mul(r, a, b, t); });
+    else
+        with_scratch(barrett.scratch_size, [&](limb_t *t) { barrett.mul(r, a, b, t); });
 }
 
-/*
-    Integer / BigInt
-    ----------------
-*/
+void ModContext::form_sqr(limb_t *r, const limb_t *a) const
+{
+    if (montgomery.n)
+        with_scratch(montgomery.scratch_size, [&](limb_t *t) { montgomery.sqr(r, a, t); });
+    else
+        with_scratch(barrett.scratch_size, [&](limb_t *t) { barrett.sqr(r, a, t); });
+}
 
-BigInt operator/(const long long &lhs, const BigInt &rhs)
+// exponent must be positive
+void ModContext::form_pow(limb_t *r, const limb_t *g, const BigInt &exponent) const
 {
-    return BigInt(lhs) / rhs;
+    const Limbs &e = exponent.magnitude;
+    if (montgomery.n)
+        powmod_window(montgomery, r, g, e.data(), e.size());
+    else
+        powmod_window(barrett, r, g, e.data(), e.size());
 }
 
+
 /*
-    BigInt % Integer
-    ----------------
+    ===========================================================================
+    Modular integers
+    ===========================================================================
+    ModInt<Modulus> is an integer modulo a modulus shared by all of its
+    values. Modulus is a tag type whose static context() returns the
+    ModContext, typically a function local static, so the modulus is fixed
+    at compile time:
+
+        struct P { static const ModContext &context(); };
+        typedef ModInt<P> Fp;
+
+    ModInt<> takes the context at run time instead, as a constructor
+    argument, and the context must outlive the values that refer to it. A
+    default constructed ModInt<> is a zero without a modulus, which takes
+    the modulus of the first value it meets.
+
+    Values are kept reduced, as n limb residues in Montgomery form when the
+    modulus is odd, so a product is one multiplication and one REDC pass.
+    The arithmetic-assignment operators work in place and don't allocate.
 */
 
-BigInt BigInt::operator%(const long long &num)
+template <class Modulus>
+struct ModIntContext
 {
-    return *this % BigInt(num);
-}
+    static const ModContext *get() { return &Modulus::context(); }
+};
+
+template <>
+struct ModIntContext<void>
+{
+    static const ModContext *get() { return nullptr; }
+};
+
+template <class Modulus = void>
+class ModInt
+{
+public:
+    // Constructors:
+    ModInt() : ctx(ModIntContext<Modulus>::get()), residue(ctx ? ctx->limbs() : 0) {}
+    // An integer converts implicitly only when the type fixes the modulus:
+    // a ModInt<> is given its ModContext with the value
+    template <class M = Modulus, class = typename std::enable_if<!std::is_void<M>::value>::type>
+    ModInt(const long long &num) : ModInt(BigInt(num)) {}
+    template <class M = Modulus, class = typename std::enable_if<!std::is_void<M>::value>::type>
+    ModInt(const BigInt &num) : ctx(ModIntContext<Modulus>::get()), residue(ctx->to_form(num)) {}
+    ModInt(const BigInt &num, const ModContext &context) : ctx(&context), residue(context.to_form(num))
+    {
+        static_assert(std::is_void<Modulus>::value, "ModInt<Modulus>: the modulus is Modulus::context()");
+    }
+
+    // The value in [0, modulus), and the modulus
+    BigInt value() const { return ctx ? ctx->from_form(residue) : BigInt(); }
+    const ModContext &context() const { return *ctx; }
+
+    bool is_zero() const
+    {
+        for (size_t i = 0; i < residue.size(); i++)
+        {
+            if (residue[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Unary arithmetic operators:
+    ModInt operator+() const { return *this; }
+    ModInt operator-() const { return ModInt() -= *this; }
+
+    // Arithmetic-assignment operators:
+    ModInt &operator+=(const ModInt &obj);
+    ModInt &operator-=(const ModInt &obj);
+    ModInt &operator*=(const ModInt &obj);
+    ModInt &operator/=(const ModInt &obj) { return *this *= obj.inverse(); }
+
+    // Binary arithmetic operators, as friends so that for a ModInt<Modulus>
+    // an integer converts on either side:
+    friend ModInt operator+(ModInt lhs, const ModInt &rhs) { return lhs += rhs; }
+    friend ModInt operator-(ModInt lhs, const ModInt &rhs) { return lhs -= rhs; }
+    friend ModInt operator*(ModInt lhs, const ModInt &rhs) { return lhs *= rhs; }
+    friend ModInt operator/(ModInt lhs, const ModInt &rhs) { return lhs /= rhs; }
+
+    // Relational operators:
+    friend bool operator==(const ModInt &lhs, const ModInt &rhs) { return lhs.equals(rhs); }
+    friend bool operator!=(const ModInt &lhs, const ModInt &rhs) { return !lhs.equals(rhs); }
+
+    // x^exponent, where a negative exponent is a power of the inverse
+    ModInt pow(const BigInt &exponent) const;
+    // Throws std::domain_error when the value and the modulus aren't coprime
+    ModInt inverse() const;
+
+    // I/O stream operators:
+    friend std::ostream &operator<<(std::ostream &output, const ModInt &obj)
+    {
+        return output << obj.value();
+    }
+
+private:
+    const ModContext *ctx; // null only for a ModInt<> that has no modulus yet
+    Limbs residue;         // ctx->limbs() limbs, in the form of ctx
+
+    ModInt(const ModContext *context, Limbs &&limbs) : ctx(context), residue(std::move(limbs)) {}
+
+    bool adopt(const ModInt &obj);
+    bool equals(const ModInt &obj) const;
+};
 
 /*
-    Integer % BigInt
-    ----------------
+    adopt
+    -----
+    Gives *this the modulus of obj when it has none yet. Returns false when
+    obj has no modulus, and so is zero.
 */
 
-BigInt operator%(const long long &lhs, const BigInt &rhs)
+template <class Modulus>
+bool ModInt<Modulus>::adopt(const ModInt &obj)
 {
-    return BigInt(lhs) % rhs;
+    if (!obj.ctx)
+        return false;
+    if (!ctx)
+    {
+        ctx = obj.ctx;
+        residue = Limbs(ctx->limbs());
+    }
+    else if (ctx != obj.ctx)
+    {
+        throw std::invalid_argument("ModInt: different moduli");
+    }
+    return true;
+}
+
+template <class Modulus>
+bool ModInt<Modulus>::equals(const ModInt &obj) const
+{
+    if (!ctx || !obj.ctx)
+        return is_zero() && obj.is_zero();
+    if (ctx != obj.ctx)
+        throw std::invalid_argument("ModInt: different moduli");
+    return cmp_n(residue.data(), obj.residue.data(), residue.size()) == 0;
 }
 
 /*
-    BigInt + String
-    ---------------
+    Arithmetic-assignment operators
+    -------------------------------
+    A sum or difference of reduced residues is corrected by adding or
+    subtracting the modulus once, in either form.
 */
 
-BigInt BigInt::operator+(const std::string &num)
+template <class Modulus>
+ModInt<Modulus> &ModInt<Modulus>::operator+=(const ModInt &obj)
 {
-    return *this + BigInt(num);
+    if (!adopt(obj))
+        return *this;
+
+    size_t n = residue.size();
+    const limb_t *m = ctx->modulus_limbs();
+    limb_t *r = residue.data();
+    limb_t carry = add_n(r, r, obj.residue.data(), n);
+    if (carry || cmp_n(r, m, n) >= 0)
+        sub_n(r, r, m, n);
+    return *this;
 }
 
-/*
-    String + BigInt
-    ---------------
-*/
+template <class Modulus>
+ModInt<Modulus> &ModInt<Modulus>::operator-=(const ModInt &obj)
+{
+    if (!adopt(obj))
+        return *this;
 
-BigInt operator+(const std::string &lhs, const BigInt &rhs)
+    size_t n = residue.size();
+    limb_t *r = residue.data();
+    if (sub_n(r, r, obj.residue.data(), n))
+        add_n(r, r, ctx->modulus_limbs(), n);
+    return *this;
+}
+
+template <class Modulus>
+ModInt<Modulus> &ModInt<Modulus>::operator*=(const ModInt &obj)
 {
-    return BigInt(lhs) + rhs;
+    if (!adopt(obj))
+    {
+        std::fill(residue.begin(), residue.end(), 0);
+        return *this;
+    }
+
+    if (&obj == this)
+        ctx->form_sqr(residue.data(), residue.data());
+    else
+        ctx->form_mul(residue.data(), residue.data(), obj.residue.data());
+    return *this;
 }
 
 /*
-    BigInt - String
-    ---------------
+    pow
+    ---
 */
 
-BigInt BigInt::operator-(const std::string &num)
+template <class Modulus>
+ModInt<Modulus> ModInt<Modulus>::pow(const BigInt &exponent) const
 {
-    return *this - BigInt(num);
+    if (exponent.sign() < 0)
+        return inverse().pow(-exponent);
+    if (exponent.is_zero())
+    {
+        if (!ctx)
+            throw std::domain_error("ModInt: 0^0 without a modulus");
+        return ModInt(ctx, ctx->to_form(1));
+    }
+    if (!ctx)
+        return *this;
+
+    Limbs r(residue.size());
+    ctx->form_pow(r.data(), residue.data(), exponent);
+    return ModInt(ctx, std::move(r));
 }
 
 /*
-    String - BigInt
-    ---------------
+    inverse
+    -------
 */
 
-BigInt operator-(const std::string &lhs, const BigInt &rhs)
+template <class Modulus>
+ModInt<Modulus> ModInt<Modulus>::inverse() const
 {
-    return BigInt(lhs) - rhs;
+    if (!ctx)
+        throw std::domain_error("invmod: not invertible");
+    return ModInt(ctx, ctx->to_form(ctx->invmod(value())));
 }
 
 /*
-    BigInt * String
-    ---------------
+    ===========================================================================
+    Exponentiation
+    ===========================================================================
+*/
+
+/*
+    pow
+    ---
+    base^exponent, where 0^0 = 1.
 */
 
-BigInt BigInt::operator*(const std::string &num)
+BigInt pow(const BigInt &base, unsigned long long exponent)
 {
-    return *this * BigInt(num);
+    /**
+     * Complexity of pow function
+     *
+     * Time complexity : O(M(n)), where n is the size of the result and M(n)
+     *                   the time of an n limb product: the last squaring
+     *                   is the largest and each one before it is half as
+     *                   large
+     * Space complexity: O(n)
+     *
+     * Algorithm of pow function
+     *      1. Powers of ten that are in the table of constants are looked up
+     *      2. Split |base| = odd * 2^k. The power of two becomes one shift by
+     *         k * exponent at the end, so a power of two (and +-1) is only
+     *         that shift, and other even bases (powers of ten too) work with
+     *         fewer limbs
+     *      3. odd^exponent by left-to-right binary exponentiation: square for
+     *         every bit of the exponent and multiply by odd for every 1 bit.
+     *         The products by odd are unbalanced and cheap next to the
+     *         squarings, so a window would save little. Two buffers of the
+     *         final size take turns, so the loop doesn't allocate
+     */
+
+    if (exponent == 0)
+        return bigint_constant(1);
+    if (base.magnitude.empty())
+        return BigInt();
+
+    short signum = (base.signum == -1 && exponent % 2 == 1) ? -1 : 1;
+    const Limbs &b = base.magnitude;
+
+    size_t zero_limbs = 0;
+    while (b[zero_limbs] == 0)
+        zero_limbs++;
+    unsigned zero_bits = __builtin_ctzll(b[zero_limbs]);
+    size_t k = zero_limbs * 64 + zero_bits;
+
+    if (k > 0 && k < POWER_TABLE_SIZE && exponent <= (POWER_TABLE_SIZE - 1) / k &&
+        magnitude_compare(b, bigint_power_of_ten(k).magnitude) == 0)
+    {
+        BigInt result = bigint_power_of_ten(k * exponent);
+        result.signum = signum;
+        return result;
+    }
+
+    size_t on = b.size() - zero_limbs;
+    Limbs odd(on);
+    if (zero_bits)
+        rshift(odd.data(), b.data() + zero_limbs, on, zero_bits);
+    else
+        std::copy(b.data() + zero_limbs, b.data() + b.size(), odd.data());
+    strip_leading_zeroes(odd);
+    on = odd.size();
+
+    // bits of the result, which must be addressable
+    size_t odd_bits = on * 64 - __builtin_clzll(odd[on - 1]);
+    size_t odd_power_bits, shift;
+    if (__builtin_mul_overflow(k, exponent, &shift))
+        throw std::length_error("pow: result too large");
+
+    // |base| is a power of two (or 1): the shift alone is the result
+    if (odd_bits == 1)
+    {
+        BigInt result = bigint_constant(signum);
+        result <<= shift;
+        return result;
+    }
+
+    if (__builtin_mul_overflow(odd_bits, exponent, &odd_power_bits) ||
+        odd_power_bits + shift < shift)
+    {
+        throw std::length_error("pow: result too large");
+    }
+
+    // room for the products below, which may have a zero top limb, and for
+    // the final shift
+    size_t limbs = odd_power_bits / 64 + 2 + shift / 64 + 1;
+    Limbs x(limbs), y(limbs);
+    std::copy(odd.begin(), odd.end(), x.data());
+    size_t xn = on;
+
+    for (int bit = 62 - __builtin_clzll(exponent); bit >= 0; bit--)
+    {
+        sqr(y.data(), x.data(), xn);
+        size_t yn = 2 * xn;
+        while (y[yn - 1] == 0)
+            yn--;
+        std::swap(x, y);
+        xn = yn;
+
+        if ((exponent >> bit) & 1)
+        {
+            if (xn >= on)
+                mul(y.data(), x.data(), xn, odd.data(), on);
+            else
+                mul(y.data(), odd.data(), on, x.data(), xn);
+            yn = xn + on;
+            while (y[yn - 1] == 0)
+                yn--;
+            std::swap(x, y);
+            xn = yn;
+        }
+    }
+
+    BigInt result;
+    x.resize(xn);
+    result.magnitude = std::move(x);
+    result.signum = signum;
+    result <<= shift;
+    return result;
 }
 
 /*
-    String * BigInt
-    ---------------
+    powmod
+    ------
+    base^exponent mod |mod|, in the range [0, |mod|) whatever the signs of
+    base and mod. The exponent can't be negative. The constants of the
+    modulus come from the per thread cache of ModContext, so only the first
+    call with a modulus pays for them.
 */
 
-BigInt operator*(const std::string &lhs, const BigInt &rhs)
+BigInt powmod(const BigInt &base, const BigInt &exponent, const BigInt &mod)
 {
-    return BigInt(lhs) * rhs;
+    return ModContext::cached(mod).powmod(base, exponent);
 }
 
+
 /*
-    BigInt / String
-    ---------------
+    ===========================================================================
+    Fused kernels
+    ===========================================================================
+    Evaluate a product straight into the limbs of *this, reusing its
+    buffer when it is large enough.
 */
 
-BigInt BigInt::operator/(const std::string &num)
+/*
+    assign_product
+    --------------
+    *this = x * y, in the buffer of *this when it is large enough. x or y
+    may be *this.
+*/
+
+void BigInt::assign_product(const BigInt &x, const BigInt &y)
 {
-    return *this / BigInt(num);
+    const Limbs &a = x.magnitude, &b = y.magnitude;
+
+    dlimb_t product;
+    if (a.empty() || b.empty())
+    {
+        this->magnitude.clear();
+    }
+    else if (is_small(a) && is_small(b)
+             && !__builtin_mul_overflow(limbs_to_dlimb(a), limbs_to_dlimb(b), &product))
+    {
+        this->magnitude = dlimb_to_limbs(product);
+    }
+    else
+    {
+        const Limbs &longer = a.size() >= b.size() ? a : b;
+        const Limbs &shorter = a.size() >= b.size() ? b : a;
+        size_t ln = longer.size(), sn = shorter.size();
+        const limb_t *lp = longer.data(), *sp = shorter.data();
+
+        // mul() can't write over an operand, so one in the buffer of *this
+        // is moved to scratch space first
+        Limbs saved;
+        if (&longer == &this->magnitude || &shorter == &this->magnitude)
+        {
+            const Limbs &self = this->magnitude;
+            saved = scratch_limbs(self.size());
+            std::copy(self.begin(), self.end(), saved.data());
+            if (&longer == &this->magnitude)
+                lp = saved.data();
+            if (&shorter == &this->magnitude)
+                sp = saved.data();
+        }
+
+        short product_sign = x.signum * y.signum;
+        this->magnitude.clear();
+        this->magnitude.resize(ln + sn);
+        mul(this->magnitude.data(), lp, ln, sp, sn);
+        strip_leading_zeroes(this->magnitude);
+        this->signum = this->magnitude.empty() ? 1 : product_sign;
+        return;
+    }
+
+    this->signum = this->magnitude.empty() ? 1 : x.signum * y.signum;
 }
 
 /*
-    String / BigInt
-    ---------------
+    add_product
+    -----------
+    *this += x * y, or *this -= x * y when subtract is set. x or y may be
+    *this.
 */
 
-BigInt operator/(const std::string &lhs, const BigInt &rhs)
-{
-    return BigInt(lhs) / rhs;
+void BigInt::add_product(const BigInt &x, const BigInt &y, bool subtract)
+{
+    if (this == &x || this == &y)
+    {
+        BigInt operand(*this);
+        add_product(this == &x ? operand : x, this == &y ? operand : y, subtract);
+        return;
+    }
+
+    short product_sign = subtract ? -x.signum * y.signum : x.signum * y.signum;
+    add_product(x.magnitude.data(), x.magnitude.size(),
+                y.magnitude.data(), y.magnitude.size(), product_sign);
 }
 
 /*
-    BigInt % String
-    ---------------
+    *this += a[0..an) * b[0..bn) * product_sign, where neither operand is in
+    the limbs of *this.
 */
 
-BigInt BigInt::operator%(const std::string &num)
+void BigInt::add_product(const limb_t *a, size_t an, const limb_t *b, size_t bn, short product_sign)
 {
-    return *this % BigInt(num);
+    if (addmul_limbs(this->magnitude, a, an, b, bn, product_sign != this->signum))
+        this->signum = product_sign;
+
+    if (this->magnitude.empty())
+        this->signum = 1;
 }
 
 /*
-    String % BigInt
-    ---------------
+    assign_product_mod
+    ------------------
+    *this = (x * y) % m, with the sign of x * y like %. The quotient of the
+    reduction is never stored.
 */
 
-BigInt operator%(const std::string &lhs, const BigInt &rhs)
+void BigInt::assign_product_mod(const BigInt &x, const BigInt &y, const BigInt &m)
 {
-    return BigInt(lhs) % rhs;
-}
+    if (m.magnitude.empty())
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
 
+    BigInt product;
+    product.assign_product(x, y);
+
+    const Limbs &a = product.magnitude, &d = m.magnitude;
+    if (magnitude_compare(a, d) < 0)
+    {
+        *this = std::move(product);
+        return;
+    }
+
+    this->magnitude.clear();
+    this->magnitude.resize(d.size());
+    divrem(nullptr, this->magnitude.data(), a.data(), a.size(), d.data(), d.size());
+    strip_leading_zeroes(this->magnitude);
+
+    this->signum = this->magnitude.empty() ? 1 : product.signum;
+}
 
 /*
     ===========================================================================
-    Arithmetic-assignment operators
+    Expression templates
     ===========================================================================
+    Opt-in lazy evaluation. lazy(x) starts an expression: +, -, * and % on it
+    build a tree of BigIntExpr nodes instead of BigInt temporaries, and the
+    tree is evaluated when it is assigned to (or used to construct, or
+    added to) a BigInt:
+
+        r = lazy(a) * b + c;         // c + a*b, the product added into r
+        r = lazy(a) * b % m;         // reduced product, no quotient stored
+        r = lazy(a) * a;             // square
+        acc += lazy(a) * b;          // multiply-accumulate into acc
+
+    A node refers to its BigInt operands, so an expression must be evaluated
+    in the statement that builds it.
 */
 
+struct ExprLeaf {};
+struct ExprAdd {};
+struct ExprSub {};
+struct ExprMul {};
+struct ExprMod {};
+struct ExprNone {};
+
 /*
-    BigInt += BigInt
-    -----------------
+    BigIntOperand
+    -------------
+    How a node stores an operand: BigInt by reference, an integer as an
+    inline BigInt, and a subexpression by value. BigIntScalar is the same
+    without subexpressions. Other types have no operand type, which keeps
+    the operators below out of overload sets they do not belong to.
 */
 
-BigInt BigInt::operator+=(BigInt &obj)
+template <class T, class Enable = void>
+struct BigIntScalar {};
+
+template <>
+struct BigIntScalar<BigInt>
 {
-    *this = *this + obj;
-    return *this;
-}
+    typedef const BigInt &type;
+};
+
+template <class T>
+struct BigIntScalar<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+    typedef BigInt type;
+};
+
+template <class T>
+struct BigIntOperand : BigIntScalar<T> {};
+
+template <class Op, class L, class R>
+struct BigIntOperand<BigIntExpr<Op, L, R> >
+{
+    typedef BigIntExpr<Op, L, R> type;
+};
 
 /*
-    BigInt -= BigInt
-    -----------------
+    materialize
+    -----------
+    The value of an operand: BigInts and lazy(x) leaves by reference, any
+    other subexpression evaluated into a temporary.
 */
 
-BigInt BigInt::operator-=(BigInt &obj)
+inline const BigInt &materialize(const BigInt &value)
 {
-    *this = *this - obj;
-    return *this;
+    return value;
 }
 
-/*
-    BigInt *= BigInt
-    -----------------
-*/
+template <class R>
+const BigInt &materialize(const BigIntExpr<ExprLeaf, const BigInt &, R> &leaf)
+{
+    return leaf.lhs;
+}
 
-BigInt BigInt::operator*=(BigInt &obj)
+template <class Op, class L, class R>
+BigInt materialize(const BigIntExpr<Op, L, R> &expr)
 {
-    *this = *this * obj;
-    return *this;
+    return BigInt(expr);
 }
 
 /*
-    BigInt /= BigInt
-    -----------------
+    expr_references
+    ---------------
+    Whether an operand reads the BigInt target, in which case the
+    expression cannot be evaluated into it directly.
 */
 
-BigInt BigInt::operator/=(BigInt &obj)
+inline bool expr_references(const BigInt &value, const BigInt &target)
 {
-    *this = *this / obj;
-    return *this;
+    return &value == &target;
 }
 
-/*
-    BigInt %= BigInt
-    -----------------
-*/
+template <class Op, class L, class R>
+bool expr_references(const BigIntExpr<Op, L, R> &expr, const BigInt &target)
+{
+    return expr_references(expr.lhs, target) || expr_references(expr.rhs, target);
+}
 
-BigInt BigInt::operator%=(BigInt &obj)
+inline bool expr_references(const ExprNone &, const BigInt &)
 {
-    *this = *this % obj;
-    return *this;
+    return false;
 }
 
 /*
-    BigInt += Integer
-    -----------------
+    expr_add_to
+    -----------
+    target += operand, or target -= operand when subtract is set. A product
+    is added with add_product() instead of being built first.
 */
 
-BigInt &BigInt::operator+=(const long long &num)
+inline void expr_add_to(BigInt &target, const BigInt &value, bool subtract)
 {
-    *this = *this + BigInt(num);
+    if (subtract)
+        target -= value;
+    else
+        target += value;
+}
 
-    return *this;
+template <class Op, class L, class R>
+void expr_add_to(BigInt &target, const BigIntExpr<Op, L, R> &expr, bool subtract)
+{
+    expr.add_to(target, subtract);
 }
 
 /*
-    BigInt -= Integer
-    -----------------
+    BigIntExpr
+    ----------
+    One node of an expression: Op applied to lhs and rhs.
 */
 
-BigInt &BigInt::operator-=(const long long &num)
+template <class Op, class L, class R>
+struct BigIntExpr
 {
-    *this = *this - BigInt(num);
+    L lhs;
+    R rhs;
 
-    return *this;
-}
+    BigIntExpr(L l, R r) : lhs(l), rhs(r) {}
+
+    // target = this expression; target must not be referenced by it
+    void assign_to(BigInt &target) const { assign(target, Op()); }
+
+    // target += this expression, or -= when subtract is set
+    void add_to(BigInt &target, bool subtract) const { add(target, subtract, Op()); }
+
+private:
+    template <class Tag>
+    void add(BigInt &target, bool subtract, Tag) const
+    {
+        expr_add_to(target, materialize(*this), subtract);
+    }
+
+    void add(BigInt &target, bool subtract, ExprMul) const
+    {
+        target.add_product(materialize(lhs), materialize(rhs), subtract);
+    }
+
+    void assign(BigInt &target, ExprLeaf) const
+    {
+        target = lhs;
+    }
+
+    void assign(BigInt &target, ExprAdd) const
+    {
+        assign_sum(target, lhs, false);
+    }
+
+    void assign(BigInt &target, ExprSub) const
+    {
+        assign_sum(target, lhs, true);
+    }
+
+    // target = product +- rhs: rhs goes into target first and the product
+    // is added to it with add_product(), the same as for rhs +- product
+    template <class A, class B>
+    void assign_sum(BigInt &target, const BigIntExpr<ExprMul, A, B> &product, bool subtract) const
+    {
+        expr_assign(target, rhs);
+        if (subtract && !target.magnitude.empty())
+            target.signum = -target.signum;
+        product.add_to(target, false);
+    }
+
+    template <class T>
+    void assign_sum(BigInt &target, const T &value, bool subtract) const
+    {
+        expr_assign(target, value);
+        expr_add_to(target, rhs, subtract);
+    }
+
+    void assign(BigInt &target, ExprMul) const
+    {
+        target.assign_product(materialize(lhs), materialize(rhs));
+    }
+
+    void assign(BigInt &target, ExprMod) const
+    {
+        reduce(target, lhs);
+    }
+
+    // (x * y) % rhs
+    template <class A, class B>
+    void reduce(BigInt &target, const BigIntExpr<ExprMul, A, B> &product) const
+    {
+        target.assign_product_mod(materialize(product.lhs), materialize(product.rhs),
+                                  materialize(rhs));
+    }
+
+    template <class T>
+    void reduce(BigInt &target, const T &value) const
+    {
+        target = materialize(value) % materialize(rhs);
+    }
+
+    static void expr_assign(BigInt &target, const BigInt &value)
+    {
+        target = value;
+    }
+
+    template <class O, class A, class B>
+    static void expr_assign(BigInt &target, const BigIntExpr<O, A, B> &expr)
+    {
+        expr.assign_to(target);
+    }
+};
 
 /*
-    BigInt *= Integer
-    -----------------
+    lazy
+    ----
+    Starts an expression on x.
 */
 
-BigInt &BigInt::operator*=(const long long &num)
+inline BigIntExpr<ExprLeaf, const BigInt &, ExprNone> lazy(const BigInt &x)
 {
-    *this = *this * BigInt(num);
-
-    return *this;
+    return BigIntExpr<ExprLeaf, const BigInt &, ExprNone>(x, ExprNone());
 }
 
 /*
-    BigInt /= Integer
-    -----------------
+    Expression operators
+    --------------------
+    Expression op (BigInt, integer or expression), and (BigInt or integer)
+    op expression.
 */
 
-BigInt &BigInt::operator/=(const long long &num)
+template <class Op, class L, class R, class T>
+BigIntExpr<ExprAdd, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>
+operator+(const BigIntExpr<Op, L, R> &lhs, const T &rhs)
 {
-    *this = *this / BigInt(num);
+    return BigIntExpr<ExprAdd, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>(lhs, rhs);
+}
 
-    return *this;
+template <class T, class Op, class L, class R>
+BigIntExpr<ExprAdd, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >
+operator+(const T &lhs, const BigIntExpr<Op, L, R> &rhs)
+{
+    return BigIntExpr<ExprAdd, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >(lhs, rhs);
 }
 
-/*
-    BigInt %= Integer
-    -----------------
-*/
+template <class Op, class L, class R, class T>
+BigIntExpr<ExprSub, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>
+operator-(const BigIntExpr<Op, L, R> &lhs, const T &rhs)
+{
+    return BigIntExpr<ExprSub, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>(lhs, rhs);
+}
 
-BigInt &BigInt::operator%=(const long long &num)
+template <class T, class Op, class L, class R>
+BigIntExpr<ExprSub, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >
+operator-(const T &lhs, const BigIntExpr<Op, L, R> &rhs)
 {
-    *this = *this % BigInt(num);
+    return BigIntExpr<ExprSub, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >(lhs, rhs);
+}
 
-    return *this;
+template <class Op, class L, class R, class T>
+BigIntExpr<ExprMul, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>
+operator*(const BigIntExpr<Op, L, R> &lhs, const T &rhs)
+{
+    return BigIntExpr<ExprMul, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>(lhs, rhs);
 }
 
-/*
-    BigInt += String
-    ----------------
-*/
+template <class T, class Op, class L, class R>
+BigIntExpr<ExprMul, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >
+operator*(const T &lhs, const BigIntExpr<Op, L, R> &rhs)
+{
+    return BigIntExpr<ExprMul, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >(lhs, rhs);
+}
 
-BigInt &BigInt::operator+=(const std::string &num)
+template <class Op, class L, class R, class T>
+BigIntExpr<ExprMod, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>
+operator%(const BigIntExpr<Op, L, R> &lhs, const T &rhs)
 {
-    *this = *this + BigInt(num);
+    return BigIntExpr<ExprMod, BigIntExpr<Op, L, R>, typename BigIntOperand<T>::type>(lhs, rhs);
+}
 
-    return *this;
+template <class T, class Op, class L, class R>
+BigIntExpr<ExprMod, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >
+operator%(const T &lhs, const BigIntExpr<Op, L, R> &rhs)
+{
+    return BigIntExpr<ExprMod, typename BigIntScalar<T>::type, BigIntExpr<Op, L, R> >(lhs, rhs);
 }
 
 /*
-    BigInt -= String
-    ----------------
+    BigInt from an expression
+    -------------------------
 */
 
-BigInt &BigInt::operator-=(const std::string &num)
+template <class Op, class L, class R>
+BigInt::BigInt(const BigIntExpr<Op, L, R> &expr)
 {
-    *this = *this - BigInt(num);
-
-    return *this;
+    signum = 1;
+    expr.assign_to(*this);
 }
 
 /*
-    BigInt *= String
-    ----------------
+    BigInt = expression
+    -------------------
+    Evaluated into the buffer of *this, unless the expression reads *this.
 */
 
-BigInt &BigInt::operator*=(const std::string &num)
+template <class Op, class L, class R>
+BigInt &BigInt::operator=(const BigIntExpr<Op, L, R> &expr)
 {
-    *this = *this * BigInt(num);
+    if (expr_references(expr, *this))
+        *this = BigInt(expr);
+    else
+        expr.assign_to(*this);
 
     return *this;
 }
 
 /*
-    BigInt /= String
-    ----------------
+    BigInt += expression
+    --------------------
 */
 
-BigInt &BigInt::operator/=(const std::string &num)
+template <class Op, class L, class R>
+BigInt &BigInt::operator+=(const BigIntExpr<Op, L, R> &expr)
 {
-    *this = *this / BigInt(num);
+    if (expr_references(expr, *this))
+        *this += BigInt(expr);
+    else
+        expr_add_to(*this, expr, false);
 
     return *this;
 }
 
 /*
-    BigInt %= String
-    ----------------
+    BigInt -= expression
+    --------------------
 */
 
-BigInt &BigInt::operator%=(const std::string &num)
+template <class Op, class L, class R>
+BigInt &BigInt::operator-=(const BigIntExpr<Op, L, R> &expr)
 {
-    *this = *this % BigInt(num);
+    if (expr_references(expr, *this))
+        *this -= BigInt(expr);
+    else
+        expr_add_to(*this, expr, true);
 
     return *this;
 }
@@ -1531,425 +6747,763 @@ BigInt &BigInt::operator%=(const std::string &num)
 
 /*
     ===========================================================================
-    Relational operators
+    FixedBigInt
     ===========================================================================
+    FixedBigInt<Bits> is a signed integer with a magnitude of at most Bits
+    bits (a multiple of 64), stored in a plain array inside the object. It
+    never allocates, and all its arithmetic is constexpr: the limb count is a
+    compile-time constant, so the compiler can unroll and inline the limb
+    kernels for each width.
+
+    It has the operators of BigInt, with the same sign and rounding rules. A
+    result that does not fit in Bits bits throws std::overflow_error.
+    Converting to a BigInt always works and converting from one is explicit.
+    Mixed FixedBigInt / BigInt arithmetic gives a BigInt.
 */
 
-/*
-    BigInt > BigInt
-    ----------------
-*/
-
-bool BigInt::operator>(BigInt &obj)
+template <size_t Bits>
+class FixedBigInt
 {
-    if (sign != obj.sign)
-    {
-        return sign > obj.sign;
-    }
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedBigInt: Bits must be a positive multiple of 64");
 
-    int val = string_compare(this->bigInteger, obj.bigInteger);
+public:
+    static const size_t LIMBS = Bits / 64;
 
-    if (val == 1)
-    {
-        if (sign == -1)
-            return false;
-        else
-            return true;
-    }
-    else if (val == -1)
+    // Constructors:
+    constexpr FixedBigInt() : magnitude(), signum(1) {}
+    constexpr FixedBigInt(const long long &num)
+        : magnitude{integer_magnitude(num)}, signum(num < 0 ? -1 : 1) {}
+    FixedBigInt(const std::string &num) : FixedBigInt(BigInt(num)) {}
+    explicit FixedBigInt(const BigInt &num);
+
+    // From another width: implicit when it widens, explicit (and throwing
+    // overflow_error if the value does not fit) when it narrows.
+    template <size_t OtherBits, typename std::enable_if<(OtherBits <= Bits), int>::type = 0>
+    constexpr FixedBigInt(const FixedBigInt<OtherBits> &num) : magnitude(), signum(num.signum)
     {
-        if (obj.sign == -1)
-            return true;
-        else
-            return false;
+        for (size_t i = 0; i < num.LIMBS; i++)
+            magnitude[i] = num.magnitude[i];
     }
-    else
+
+    template <size_t OtherBits, typename std::enable_if<(OtherBits > Bits), int>::type = 0>
+    explicit constexpr FixedBigInt(const FixedBigInt<OtherBits> &num) : magnitude(), signum(num.signum)
     {
-        return false;
+        if (num.used() > LIMBS)
+            throw std::overflow_error("FixedBigInt: result does not fit");
+        for (size_t i = 0; i < LIMBS; i++)
+            magnitude[i] = num.magnitude[i];
     }
-}
 
-/*
-    BigInt < BigInt
-    ----------------
-*/
+    // Conversion to BigInt:
+    explicit operator BigInt() const;
 
-bool BigInt::operator<(BigInt &obj)
-{
-    if (sign != obj.sign)
+    // Unary arithmetic operators:
+    constexpr FixedBigInt operator+() const { return *this; }
+    constexpr FixedBigInt operator-() const
     {
-        return sign < obj.sign;
+        FixedBigInt temp = *this;
+        if (!temp.is_zero())
+            temp.signum = -temp.signum;
+        return temp;
     }
 
-    int val = string_compare(this->bigInteger, obj.bigInteger);
+    // Arithmetic-assignment operators:
+    constexpr FixedBigInt &operator+=(const FixedBigInt &obj) { add(obj, false); return *this; }
+    constexpr FixedBigInt &operator-=(const FixedBigInt &obj) { add(obj, true); return *this; }
+    constexpr FixedBigInt &operator*=(const FixedBigInt &obj);
+    constexpr FixedBigInt &operator/=(const FixedBigInt &obj);
+    constexpr FixedBigInt &operator%=(const FixedBigInt &obj);
+    constexpr FixedBigInt &operator<<=(size_t bits);
+    constexpr FixedBigInt &operator>>=(size_t bits);
 
-    if (val == 1)
-    {
-        if (sign == -1)
-            return true;
-        else
-            return false;
-    }
-    else if (val == -1)
+    // Increment and decrement operators:
+    constexpr FixedBigInt &operator++() { return *this += 1; }
+    constexpr FixedBigInt operator++(int) { FixedBigInt temp = *this; *this += 1; return temp; }
+    constexpr FixedBigInt &operator--() { return *this -= 1; }
+    constexpr FixedBigInt operator--(int) { FixedBigInt temp = *this; *this -= 1; return temp; }
+
+    // Binary arithmetic operators, as friends so that an integer or a
+    // string converts on either side:
+    friend constexpr FixedBigInt operator+(FixedBigInt lhs, const FixedBigInt &rhs) { return lhs += rhs; }
+    friend constexpr FixedBigInt operator-(FixedBigInt lhs, const FixedBigInt &rhs) { return lhs -= rhs; }
+    friend constexpr FixedBigInt operator*(FixedBigInt lhs, const FixedBigInt &rhs) { return lhs *= rhs; }
+    friend constexpr FixedBigInt operator/(FixedBigInt lhs, const FixedBigInt &rhs) { return lhs /= rhs; }
+    friend constexpr FixedBigInt operator%(FixedBigInt lhs, const FixedBigInt &rhs) { return lhs %= rhs; }
+    constexpr FixedBigInt operator<<(size_t bits) const { FixedBigInt temp = *this; return temp <<= bits; }
+    constexpr FixedBigInt operator>>(size_t bits) const { FixedBigInt temp = *this; return temp >>= bits; }
+
+    // Relational operators:
+    friend constexpr bool operator==(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) == 0; }
+    friend constexpr bool operator!=(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) != 0; }
+    friend constexpr bool operator<(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) < 0; }
+    friend constexpr bool operator>(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) > 0; }
+    friend constexpr bool operator<=(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) <= 0; }
+    friend constexpr bool operator>=(const FixedBigInt &lhs, const FixedBigInt &rhs) { return lhs.compare(rhs) >= 0; }
+
+    // Logical operators:
+    constexpr bool operator!() const { return is_zero(); }
+    friend constexpr bool operator&&(const FixedBigInt &lhs, const FixedBigInt &rhs) { return !lhs.is_zero() && !rhs.is_zero(); }
+    friend constexpr bool operator||(const FixedBigInt &lhs, const FixedBigInt &rhs) { return !lhs.is_zero() || !rhs.is_zero(); }
+
+    // I/O stream operators:
+    friend std::ostream &operator<<(std::ostream &output, const FixedBigInt &obj)
     {
-        if (obj.sign == -1)
-            return false;
-        else
-            return true;
+        return output << BigInt(obj);
     }
-    else
+
+    friend std::istream &operator>>(std::istream &input, FixedBigInt &obj)
     {
-        return false;
+        BigInt value;
+        input >> value;
+        obj = FixedBigInt(value);
+        return input;
     }
-}
 
-/*
-    BigInt == BigInt
-    ----------------
-*/
+    // Conversion functions:
+    std::string to_string() const { return BigInt(*this).to_string(); }
+    int to_int() const { return BigInt(*this).to_int(); }
+    long to_long() const { return BigInt(*this).to_long(); }
+    long long to_long_long() const { return BigInt(*this).to_long_long(); }
 
-bool BigInt::operator==(BigInt &obj)
-{
-    if (sign != obj.sign)
-    {
-        return false;
-    }
+    // Number of decimal digits, and the digit at index, counting from the
+    // most significant one:
+    constexpr int length() const;
+    constexpr FixedBigInt operator[](int index) const;
 
-    int val = string_compare(this->bigInteger, obj.bigInteger);
+    // Sign queries:
+    constexpr bool is_zero() const { return used() == 0; }
+    constexpr bool is_one() const { return used() == 1 && magnitude[0] == 1 && signum == 1; }
+    constexpr int sign() const { return is_zero() ? 0 : signum; }
 
-    if (val == 0)
+private:
+    template <size_t OtherBits>
+    friend class FixedBigInt;
+    template <char... Digits>
+    friend struct BigIntLiteral;
+
+    limb_t magnitude[LIMBS];
+    short signum;
+
+    // number of limbs up to the highest non-zero one
+    constexpr size_t used() const
     {
-        return true;
+        size_t n = LIMBS;
+        while (n > 0 && magnitude[n - 1] == 0)
+            n--;
+        return n;
     }
-    else
+
+    constexpr int compare(const FixedBigInt &obj) const
     {
-        return false;
+        if (signum != obj.signum)
+            return signum;
+        return signum * cmp_n(magnitude, obj.magnitude, LIMBS);
     }
-}
-
-/*
-    BigInt >= BigInt
-    ----------------
-*/
-
-bool BigInt::operator>=(BigInt &obj)
-{
-    if (*this > obj)
-        return true;
-    else if (*this == obj)
-        return true;
-    else
-        return false;
-}
-
-/*
-    BigInt <= BigInt
-    ----------------
-*/
 
-bool BigInt::operator<=(BigInt &obj)
-{
-    if (*this < obj)
-        return true;
-    else if (*this == obj)
-        return true;
-    else
-        return false;
-}
+    constexpr void add(const FixedBigInt &obj, bool subtract);
+
+    static constexpr void divide(const FixedBigInt &a, const FixedBigInt &b,
+                                 FixedBigInt *quotient, FixedBigInt *rem);
+};
 
 /*
-    BigInt != BigInt
-    ----------------
+    FixedBigInt + FixedBigInt
+    -------------------------
+    *this += obj, or *this -= obj when subtract is set.
 */
 
-bool BigInt::operator!=(BigInt &obj)
+template <size_t Bits>
+constexpr void FixedBigInt<Bits>::add(const FixedBigInt &obj, bool subtract)
 {
-    if (*this == obj)
+    short obj_sign = subtract ? -obj.signum : obj.signum;
+
+    if (signum == obj_sign)
     {
-        return false;
+        if (add_n(magnitude, magnitude, obj.magnitude, LIMBS))
+            throw std::overflow_error("FixedBigInt: result does not fit");
+    }
+    else if (cmp_n(magnitude, obj.magnitude, LIMBS) >= 0)
+    {
+        sub_n(magnitude, magnitude, obj.magnitude, LIMBS);
     }
     else
     {
-        return true;
+        sub_n(magnitude, obj.magnitude, magnitude, LIMBS);
+        signum = obj_sign;
     }
+
+    if (is_zero())
+        signum = 1;
 }
 
 /*
-    BigInt == Integer
-    -----------------
+    length / operator[]
+    -------------------
+    The decimal digits of |*this|, 19 at a time by divrem_1 on a copy of the
+    limbs. An index out of range exits like the operator[] of BigInt.
 */
 
-bool BigInt::operator==(const long long &num)
+template <size_t Bits>
+constexpr int FixedBigInt<Bits>::length() const
 {
-    BigInt temp(num);
-    return *this == temp;
-}
+    limb_t work[LIMBS] = {};
+    for (size_t i = 0; i < LIMBS; i++)
+        work[i] = magnitude[i];
 
-/*
-    Integer == BigInt
-    -----------------
-*/
+    size_t n = used();
+    int digits = 0;
+    while (n > 0)
+    {
+        limb_t chunk = divrem_1(work, work, n, DECIMAL_BASE);
+        while (n > 0 && work[n - 1] == 0)
+            n--;
+        if (n > 0)
+            digits += DECIMAL_BASE_DIGITS;
+        for (; n == 0 && chunk; chunk /= 10)
+            digits++;
+    }
+    return digits ? digits : 1;
+}
 
-bool operator==(const long long &lhs, const BigInt &rhs)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> FixedBigInt<Bits>::operator[](int index) const
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 == temp2;
+    int digits = length();
+    if (index < 0 || digits <= index)
+    {
+        std::cout << "Error: Index out of bounds" << std::endl;
+        exit(1);
+    }
+
+    limb_t work[LIMBS] = {};
+    for (size_t i = 0; i < LIMBS; i++)
+        work[i] = magnitude[i];
+
+    // drop the digits below index, then take the last one
+    int below = digits - 1 - index;
+    for (; below >= DECIMAL_BASE_DIGITS; below -= DECIMAL_BASE_DIGITS)
+        divrem_1(work, work, LIMBS, DECIMAL_BASE);
+    limb_t power = 1;
+    for (int i = 0; i < below; i++)
+        power *= 10;
+    divrem_1(work, work, LIMBS, power);
+    return FixedBigInt((long long)divrem_1(work, work, LIMBS, 10));
 }
 
 /*
-    BigInt != Integer
-    -----------------
+    FixedBigInt *= FixedBigInt
+    --------------------------
+    Schoolbook product of the used limbs into a double width buffer.
 */
 
-bool BigInt::operator!=(const long long &num)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> &FixedBigInt<Bits>::operator*=(const FixedBigInt &obj)
 {
-    BigInt temp(num);
-    return !(*this == temp);
-}
+    size_t an = used(), bn = obj.used();
+    limb_t product[2 * LIMBS] = {};
 
-/*
-    Integer != BigInt
-    -----------------
-*/
+    for (size_t j = 0; j < bn; j++)
+        product[an + j] = addmul_1(product + j, magnitude, an, obj.magnitude[j]);
 
-bool operator!=(const long long &lhs, const BigInt &rhs)
-{
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 != temp2;
-}
+    for (size_t i = LIMBS; i < 2 * LIMBS; i++)
+    {
+        if (product[i])
+            throw std::overflow_error("FixedBigInt: result does not fit");
+    }
 
-/*
-    BigInt < Integer
-    ----------------
-*/
+    for (size_t i = 0; i < LIMBS; i++)
+        magnitude[i] = product[i];
+    signum = is_zero() ? 1 : signum * obj.signum;
 
-bool BigInt::operator<(const long long &num)
-{
-    BigInt temp(num);
-    return *this < temp;
+    return *this;
 }
 
 /*
-    Integer < BigInt
-    ----------------
+    divide
+    ------
+    |a| / |b| and |a| % |b| with Knuth's Algorithm D. Either output may be
+    null.
 */
 
-bool operator<(const long long &lhs, const BigInt &rhs)
+template <size_t Bits>
+constexpr void FixedBigInt<Bits>::divide(const FixedBigInt &a, const FixedBigInt &b,
+                                         FixedBigInt *quotient, FixedBigInt *rem)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 < temp2;
-}
+    size_t an = a.used(), dn = b.used();
+    if (dn == 0)
+    {
+        std::cout << "Can't divided by zero" << std::endl;
+        exit(1);
+    }
 
-/*
-    BigInt > Integer
-    ----------------
-*/
+    FixedBigInt q, r;
+    if (cmp_n(a.magnitude, b.magnitude, LIMBS) < 0)
+    {
+        r = a;
+    }
+    else
+    {
+        // normalize so that the top bit of the divisor is set
+        unsigned shift = __builtin_clzll(b.magnitude[dn - 1]);
+        limb_t u[LIMBS + 1] = {}, v[LIMBS] = {};
+        if (shift)
+        {
+            lshift(v, b.magnitude, dn, shift);
+            u[an] = lshift(u, a.magnitude, an, shift);
+        }
+        else
+        {
+            for (size_t i = 0; i < dn; i++)
+                v[i] = b.magnitude[i];
+            for (size_t i = 0; i < an; i++)
+                u[i] = a.magnitude[i];
+        }
 
-bool BigInt::operator>(const long long &num)
-{
-    BigInt temp(num);
-    return *this > temp;
-}
+        div_basecase(q.magnitude, u, an + 1, v, dn);
 
-/*
-    Integer > BigInt
-    ----------------
-*/
+        if (shift)
+            rshift(r.magnitude, u, dn, shift);
+        else
+        {
+            for (size_t i = 0; i < dn; i++)
+                r.magnitude[i] = u[i];
+        }
+    }
 
-bool operator>(const long long &lhs, const BigInt &rhs)
-{
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 > temp2;
+    if (quotient)
+        *quotient = q;
+    if (rem)
+        *rem = r;
 }
 
 /*
-    BigInt <= Integer
-    -----------------
+    FixedBigInt /= FixedBigInt
+    --------------------------
 */
 
-bool BigInt::operator<=(const long long &num)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> &FixedBigInt<Bits>::operator/=(const FixedBigInt &obj)
 {
-    BigInt temp(num);
-    return !(*this > temp);
+    short result_sign = signum * obj.signum;
+    divide(*this, obj, this, nullptr);
+    signum = is_zero() ? 1 : result_sign;
+
+    return *this;
 }
 
 /*
-    Integer <= BigInt
-    -----------------
+    FixedBigInt %= FixedBigInt
+    --------------------------
+    The remainder has the sign of the dividend, as for BigInt.
 */
 
-bool operator<=(const long long &lhs, const BigInt &rhs)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> &FixedBigInt<Bits>::operator%=(const FixedBigInt &obj)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 <= temp2;
+    short result_sign = signum;
+    divide(*this, obj, nullptr, this);
+    signum = is_zero() ? 1 : result_sign;
+
+    return *this;
 }
 
 /*
-    BigInt >= Integer
+    FixedBigInt <<= n
     -----------------
 */
 
-bool BigInt::operator>=(const long long &num)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> &FixedBigInt<Bits>::operator<<=(size_t bits)
 {
-    BigInt temp(num);
-    return !(*this < temp);
+    if (is_zero() || bits == 0)
+        return *this;
+
+    size_t n = used();
+    size_t limbs = bits / 64;
+    unsigned shift = bits % 64;
+
+    if (bits >= Bits || n + limbs > LIMBS
+        || (shift && n + limbs == LIMBS && (magnitude[n - 1] >> (64 - shift))))
+        throw std::overflow_error("FixedBigInt: result does not fit");
+
+    limb_t out = shift ? lshift(magnitude, magnitude, n, shift) : 0;
+    if (out)
+        magnitude[n++] = out;
+
+    if (limbs)
+    {
+        for (size_t i = n; i-- > 0;)
+            magnitude[i + limbs] = magnitude[i];
+        for (size_t i = 0; i < limbs; i++)
+            magnitude[i] = 0;
+    }
+
+    return *this;
 }
 
 /*
-    Integer >= BigInt
+    FixedBigInt >>= n
     -----------------
+    Rounds toward negative infinity, as for BigInt.
 */
 
-bool operator>=(const long long &lhs, const BigInt &rhs)
+template <size_t Bits>
+constexpr FixedBigInt<Bits> &FixedBigInt<Bits>::operator>>=(size_t bits)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 >= temp2;
-}
+    if (is_zero() || bits == 0)
+        return *this;
 
-/*
-    BigInt == String
-    ----------------
-*/
+    size_t limbs = bits / 64;
+    unsigned shift = bits % 64;
 
-bool BigInt::operator==(const std::string &num)
-{
-    BigInt temp(num);
-    return *this == temp;
+    bool round_down = false;
+    if (signum == -1)
+    {
+        for (size_t i = 0; i < limbs && i < LIMBS && !round_down; i++)
+            round_down = magnitude[i] != 0;
+        if (limbs < LIMBS && shift)
+            round_down = round_down || (magnitude[limbs] << (64 - shift)) != 0;
+    }
+
+    if (limbs >= LIMBS)
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+            magnitude[i] = 0;
+    }
+    else
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+            magnitude[i] = i + limbs < LIMBS ? magnitude[i + limbs] : 0;
+        if (shift)
+            rshift(magnitude, magnitude, LIMBS - limbs, shift);
+    }
+
+    if (round_down)
+        add_1(magnitude, magnitude, LIMBS, 1);
+    else if (is_zero())
+        signum = 1;
+
+    return *this;
 }
 
 /*
-    String == BigInt
-    ----------------
+    BigInt to FixedBigInt
+    ---------------------
+    NOTE: throws out_of_range if the value needs more than Bits bits.
 */
 
-bool operator==(const std::string &lhs, const BigInt &rhs)
+template <size_t Bits>
+FixedBigInt<Bits>::FixedBigInt(const BigInt &num) : magnitude(), signum(num.signum)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 == temp2;
+    if (num.magnitude.size() > LIMBS)
+        throw std::out_of_range("FixedBigInt: value does not fit");
+
+    std::copy(num.magnitude.begin(), num.magnitude.end(), magnitude);
 }
 
 /*
-    BigInt != String
-    ----------------
+    FixedBigInt to BigInt
+    ---------------------
 */
 
-bool BigInt::operator!=(const std::string &num)
+template <size_t Bits>
+FixedBigInt<Bits>::operator BigInt() const
 {
-    BigInt temp(num);
-    return !(*this == temp);
+    BigInt object;
+    size_t n = used();
+    object.magnitude.resize(n);
+    std::copy(magnitude, magnitude + n, object.magnitude.data());
+    object.signum = signum;
+
+    return object;
 }
 
 /*
-    String != BigInt
-    ----------------
+    Mixed FixedBigInt and BigInt operators
+    --------------------------------------
+    The FixedBigInt operand is converted, and the result is a BigInt. T is
+    always BigInt; as a template parameter it keeps integers on the
+    FixedBigInt operators above.
 */
 
-bool operator!=(const std::string &lhs, const BigInt &rhs)
-{
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 != temp2;
-}
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator+(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) + rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator+(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs + BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator-(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) - rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator-(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs - BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator*(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) * rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator*(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs * BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator/(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) / rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator/(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs / BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator%(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) % rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, BigInt>::type
+operator%(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs % BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator==(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) == rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator==(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs == BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator!=(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) != rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator!=(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs != BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator<(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) < rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator<(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs < BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator>(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) > rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator>(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs > BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator<=(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) <= rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator<=(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs <= BigInt(rhs); }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator>=(const FixedBigInt<Bits> &lhs, const T &rhs) { return BigInt(lhs) >= rhs; }
+
+template <size_t Bits, class T>
+typename std::enable_if<std::is_same<T, BigInt>::value, bool>::type
+operator>=(const T &lhs, const FixedBigInt<Bits> &rhs) { return lhs >= BigInt(rhs); }
+
 
 /*
-    BigInt < String
-    ---------------
-*/
+    ===========================================================================
+    Literals
+    ===========================================================================
+    123_big is a BigInt and 123_fixed is the smallest FixedBigInt that holds
+    the value. The digits are checked and converted to limbs at compile
+    time, so an invalid literal does not compile:
 
-bool BigInt::operator<(const std::string &num)
-{
-    BigInt temp(num);
-    return *this < temp;
-}
+        BigInt big1 = 9876543210123456789098765432101234567890_big;
+        constexpr FixedBigInt<256> k = 0xffffffffffffffffffffffffffffffff_fixed;
+
+    Decimal, 0x hexadecimal, 0b binary and 0 octal literals are accepted,
+    with or without ' digit separators, as for built-in integer literals.
+
+    A BigInt cannot be constexpr because it may own a heap buffer, so _big
+    keeps the limbs in a constant array and the BigInt copies them, without
+    any parsing. _fixed values are constexpr all the way and can fill
+    constant tables.
+*/
 
 /*
-    String < BigInt
-    ---------------
+    literal_base
+    ------------
+    The base of an integer literal, and the length of its prefix.
 */
 
-bool operator<(const std::string &lhs, const BigInt &rhs)
+constexpr unsigned literal_base(const char *text, size_t n, size_t &prefix)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 < temp2;
+    prefix = 0;
+    if (n >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        prefix = 2;
+        return 16;
+    }
+    if (n >= 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B'))
+    {
+        prefix = 2;
+        return 2;
+    }
+    if (n >= 2 && text[0] == '0')
+    {
+        prefix = 1;
+        return 8;
+    }
+    return 10;
 }
 
 /*
-    BigInt > String
-    ---------------
+    literal_digit
+    -------------
+    Value of a digit character, or -1 if it is not a digit.
 */
 
-bool BigInt::operator>(const std::string &num)
+constexpr int literal_digit(char c)
 {
-    BigInt temp(num);
-    return *this > temp;
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
 }
 
 /*
-    String > BigInt
-    ---------------
+    literal_is_valid
+    ----------------
+    Whether text[0..n) is an integer literal with at least one digit, all
+    of them below its base.
 */
 
-bool operator>(const std::string &lhs, const BigInt &rhs)
+constexpr bool literal_is_valid(const char *text, size_t n)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 > temp2;
+    size_t prefix = 0;
+    unsigned base = literal_base(text, n, prefix);
+
+    bool any_digit = base == 8;
+    for (size_t i = prefix; i < n; i++)
+    {
+        if (text[i] == '\'')
+            continue;
+
+        int digit = literal_digit(text[i]);
+        if (digit < 0 || (unsigned)digit >= base)
+            return false;
+        any_digit = true;
+    }
+    return any_digit;
 }
 
 /*
-    BigInt <= String
-    ----------------
+    LiteralLimbs
+    ------------
+    The magnitude of a literal: limbs[0..size) of at most N limbs.
 */
 
-bool BigInt::operator<=(const std::string &num)
+template <size_t N>
+struct LiteralLimbs
 {
-    BigInt temp(num);
-    return !(*this > temp);
-}
+    limb_t limbs[N];
+    size_t size;
+};
 
 /*
-    String <= BigInt
-    ----------------
+    parse_literal
+    -------------
+    Converts a valid literal to limbs, one digit at a time with mul_1 and
+    add_1. N must leave room for 4 bits per digit.
 */
 
-bool operator<=(const std::string &lhs, const BigInt &rhs)
+template <size_t N>
+constexpr LiteralLimbs<N> parse_literal(const char *text, size_t n)
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 <= temp2;
+    LiteralLimbs<N> result = {};
+    size_t prefix = 0;
+    unsigned base = literal_base(text, n, prefix);
+
+    for (size_t i = prefix; i < n; i++)
+    {
+        if (text[i] == '\'')
+            continue;
+
+        limb_t carry = mul_1(result.limbs, result.limbs, result.size, base);
+        if (carry)
+            result.limbs[result.size++] = carry;
+
+        carry = add_1(result.limbs, result.limbs, result.size, literal_digit(text[i]));
+        if (carry)
+            result.limbs[result.size++] = carry;
+    }
+    return result;
 }
 
 /*
-    BigInt >= String
-    ----------------
+    BigIntLiteral
+    -------------
+    The limbs of one literal, computed once at compile time.
 */
 
-bool BigInt::operator>=(const std::string &num)
+template <char... Digits>
+struct BigIntLiteral
 {
-    BigInt temp(num);
-    return !(*this < temp);
-}
+    static constexpr char text[sizeof...(Digits)] = {Digits...};
+    static_assert(literal_is_valid(text, sizeof...(Digits)), "invalid BigInt literal");
+
+    // an invalid literal is parsed as empty, so that only the assertion
+    // above is reported
+    static constexpr LiteralLimbs<sizeof...(Digits) / 16 + 1> value
+        = parse_literal<sizeof...(Digits) / 16 + 1>(
+            text, literal_is_valid(text, sizeof...(Digits)) ? sizeof...(Digits) : 0);
+
+    static const size_t BITS = 64 * (value.size ? value.size : 1);
+
+    static BigInt to_big()
+    {
+        BigInt object;
+        object.magnitude.resize(value.size);
+        std::copy(value.limbs, value.limbs + value.size, object.magnitude.data());
+        return object;
+    }
+
+    static constexpr FixedBigInt<BITS> to_fixed()
+    {
+        FixedBigInt<BITS> object;
+        for (size_t i = 0; i < value.size; i++)
+            object.magnitude[i] = value.limbs[i];
+        return object;
+    }
+};
+
+template <char... Digits>
+constexpr char BigIntLiteral<Digits...>::text[sizeof...(Digits)];
+
+template <char... Digits>
+constexpr LiteralLimbs<sizeof...(Digits) / 16 + 1> BigIntLiteral<Digits...>::value;
 
 /*
-    String >= BigInt
-    ----------------
+    _big / _fixed
+    -------------
 */
 
-bool operator>=(const std::string &lhs, const BigInt &rhs)
+template <char... Digits>
+BigInt operator""_big()
 {
-    BigInt temp1(lhs);
-    BigInt temp2(rhs);
-    return temp1 >= temp2;
+    return BigIntLiteral<Digits...>::to_big();
 }
 
-BigInt::~BigInt()
+template <char... Digits>
+constexpr FixedBigInt<BigIntLiteral<Digits...>::BITS> operator""_fixed()
 {
-}
\ No newline at end of file
+    return BigIntLiteral<Digits...>::to_fixed();
+}
@@ -0,0 +1,102 @@
+/*
+    addmul
+    ------
+    addmul() and submul() against acc + a * b and acc - a * b computed
+    separately, for every sign, for accumulators shorter and longer than
+    the product and close to it, on both sides of the Karatsuba threshold,
+    and with the accumulator as an operand.
+
+        g++ -std=c++14 -O2 tests/addmul.cpp -o addmul && ./addmul
+*/
+
+#include "check.h"
+#include <climits>
+
+void check_addmul(const BigInt &acc, const BigInt &a, const BigInt &b, const std::string &what)
+{
+    BigInt x = acc;
+    x.addmul(a, b);
+    check(x == acc + a * b, "addmul " + what);
+    x = acc;
+    x.submul(a, b);
+    check(x == acc - a * b, "submul " + what);
+}
+
+int main()
+{
+    const size_t sizes[] = {0, 1, 2, 5, 31, 32, 33, 70};
+    for (size_t an : sizes)
+    {
+        for (size_t bn : sizes)
+        {
+            BigInt a = random_bigint(an), b = random_bigint(bn);
+            std::string what = limbs_name("", an, bn);
+            for (size_t cn : {(size_t)0, (size_t)1, an + bn, an + bn + 3})
+                check_addmul(random_bigint(cn), a, b, what + " into " + std::to_string(cn));
+
+            // accumulators that cancel all or nearly all of the product
+            BigInt product = a * b;
+            for (long long delta : {0LL, 1LL, -1LL})
+            {
+                check_addmul(product + delta, a, -b, what + " cancelling");
+                check_addmul(product + delta, a, b, what + " cancelling");
+            }
+
+            // the accumulator is an operand
+            BigInt x = a;
+            x.addmul(x, b);
+            check(x == a + a * b, "acc.addmul(acc, b) " + what);
+            x = a;
+            x.submul(b, x);
+            check(x == a - b * a, "acc.submul(b, acc) " + what);
+            x = a;
+            x.addmul(x, x);
+            check(x == a + a * a, "acc.addmul(acc, acc) " + what);
+        }
+    }
+
+    // Word operands
+    for (size_t an : sizes)
+    {
+        BigInt a = random_bigint(an), acc = random_bigint(an + 1);
+        for (long long w : {0LL, 1LL, -1LL, 3LL, LLONG_MAX, LLONG_MIN})
+        {
+            BigInt x = acc;
+            x.addmul(a, w);
+            check(x == acc + a * BigInt(w), "addmul word " + std::to_string(an));
+            x = acc;
+            x.submul(a, w);
+            check(x == acc - a * BigInt(w), "submul word " + std::to_string(an));
+        }
+    }
+
+    // Every multiplication tier under the accumulation
+    {
+        ThresholdScope thresholds;
+        KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12, FFT_THRESHOLD = 40;
+        for (size_t n : {3, 8, 20, 60})
+            check_addmul(random_bigint(2 * n), random_bigint(n), random_bigint(n - 1), "low thresholds");
+    }
+
+    // A dot product into an accumulator with room makes no allocation
+    std::vector<BigInt> u, v;
+    BigInt expected = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        u.push_back(random_bigint(8, false));
+        v.push_back(random_bigint(8, false));
+        expected += u.back() * v.back();
+    }
+    BigInt dot = expected * 2;
+    dot -= dot;
+    CountingAllocator counter;
+    {
+        BigIntAllocatorScope scope(counter);
+        for (int i = 0; i < 100; i++)
+            dot.addmul(u[i], v[i]);
+    }
+    check(dot == expected, "dot product");
+    check(counter.allocations == 0, "dot product allocates: " + std::to_string(counter.allocations));
+
+    return finish("addmul");
+}
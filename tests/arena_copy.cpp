@@ -0,0 +1,39 @@
+/*
+    arena_copy
+    ----------
+    A copy of an arena value made after the scope of the arena must keep its
+    digits when the arena is reset and reused.
+
+        g++ -std=c++14 -O2 tests/arena_copy.cpp -o arena_copy && ./arena_copy
+*/
+
+#include "../BigInt.cpp"
+
+int main()
+{
+    BigIntArena arena;
+    BigInt result;
+    {
+        BigIntAllocatorScope scope(arena);
+        result = pow(BigInt(3), 20000); // about 500 limbs
+    }
+    const std::string expected = result.to_string();
+
+    BigInt kept = result, kept2;
+    kept2 = result;
+    result = BigInt();
+    arena.reset();
+    {
+        BigIntAllocatorScope scope(arena);
+        BigInt overwrite = pow(BigInt(7), 20000);
+        overwrite += 1;
+    }
+
+    if (kept.to_string() != expected || kept2.to_string() != expected)
+    {
+        std::cout << "arena_copy: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "arena_copy: passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+    check.h
+    -------
+    Helpers shared by the test programs. Each test is a single program that
+    includes BigInt.cpp through this header, so it can reach the limb
+    kernels and the tuning globals, and returns a non zero status when a
+    check fails.
+*/
+
+#include "../BigInt.cpp"
+#include <random>
+
+int failures = 0;
+
+// Records a failure, printing what was checked for the first few
+void check(bool ok, const std::string &what)
+{
+    if (!ok && ++failures <= 10)
+        std::cout << "FAILED: " << what << std::endl;
+}
+
+// Prints the verdict of the test and returns its exit status
+int finish(const char *name)
+{
+    std::cout << name << (failures ? ": FAILED" : ": passed") << std::endl;
+    return failures ? 1 : 0;
+}
+
+// Random numbers with a fixed seed, so that a failure can be reproduced
+std::mt19937_64 &test_rng()
+{
+    static std::mt19937_64 rng(20201229);
+    return rng;
+}
+
+// n random limbs with a non zero top limb. Some draws are all ones or
+// sparse, which are the operands that stress carries and corrections.
+Limbs random_limbs(size_t n)
+{
+    Limbs r(n);
+    unsigned shape = test_rng()() % 8;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (shape == 0)
+            r[i] = ~(limb_t)0;
+        else if (shape == 1)
+            r[i] = test_rng()() % 16 == 0 ? test_rng()() : 0;
+        else
+            r[i] = test_rng()();
+    }
+    if (n && r[n - 1] == 0)
+        r[n - 1] = 1;
+    return r;
+}
+
+// A BigInt of exactly n limbs (zero for n = 0), negative about half the time
+BigInt random_bigint(size_t n, bool allow_negative = true)
+{
+    Limbs r = random_limbs(n);
+    BigInt result = 0;
+    for (size_t i = n; i-- > 0;)
+    {
+        result <<= 32;
+        result += (long long)(r[i] >> 32);
+        result <<= 32;
+        result += (long long)(r[i] & 0xffffffff);
+    }
+    if (allow_negative && test_rng()() % 2)
+        result = -result;
+    return result;
+}
+
+std::string limbs_name(const char *what, size_t an, size_t bn)
+{
+    return std::string(what) + " " + std::to_string(an) + "x" + std::to_string(bn);
+}
+
+// Restores every tuning threshold when it goes out of scope, so a test can
+// force the tiers it checks
+struct ThresholdScope
+{
+    size_t karatsuba = KARATSUBA_THRESHOLD, toom3 = TOOM3_THRESHOLD, toom4 = TOOM4_THRESHOLD,
+           fft = FFT_THRESHOLD, dc_div = DC_DIV_THRESHOLD, hgcd = HGCD_THRESHOLD,
+           copy_on_write = COPY_ON_WRITE_THRESHOLD;
+
+    ~ThresholdScope()
+    {
+        KARATSUBA_THRESHOLD = karatsuba;
+        TOOM3_THRESHOLD = toom3;
+        TOOM4_THRESHOLD = toom4;
+        FFT_THRESHOLD = fft;
+        DC_DIV_THRESHOLD = dc_div;
+        HGCD_THRESHOLD = hgcd;
+        COPY_ON_WRITE_THRESHOLD = copy_on_write;
+    }
+};
+
+// Counts the buffers allocated while it is current
+struct CountingAllocator : BigIntAllocator
+{
+    size_t allocations = 0;
+
+    limb_t *allocate(size_t n) override
+    {
+        allocations++;
+        return new limb_t[n];
+    }
+
+    void deallocate(limb_t *p, size_t) override { delete[] p; }
+};
+
+bool same_limbs(const Limbs &a, const Limbs &b)
+{
+    return a.size() == b.size() && std::equal(a.data(), a.data() + a.size(), b.data());
+}
+
+// Checks mul() on random an x bn limb operands, an >= bn, against
+// mul_basecase() under the thresholds in force
+void check_mul(size_t an, size_t bn, const char *what)
+{
+    Limbs a = random_limbs(an), b = random_limbs(bn), r(an + bn), expected(an + bn);
+    mul(r.data(), a.data(), an, b.data(), bn);
+    mul_basecase(expected.data(), a.data(), an, b.data(), bn);
+    check(same_limbs(r, expected), limbs_name(what, an, bn));
+}
+
+// Checks divrem() of a by d under the thresholds in force: q * d + r must
+// give a back with r < d, computed with the schoolbook product
+void check_divrem(const Limbs &a, const Limbs &d, const std::string &what)
+{
+    size_t an = a.size(), dn = d.size(), qn = an - dn + 1;
+    Limbs q(qn), r(dn), back(an + 1);
+    divrem(q.data(), r.data(), a.data(), an, d.data(), dn);
+
+    mul_basecase(back.data(), q.data(), qn, d.data(), dn);
+    add(back.data(), back.data(), an + 1, r.data(), dn);
+    bool ok = back[an] == 0 && std::equal(a.data(), a.data() + an, back.data());
+
+    size_t i = dn;
+    while (i > 0 && r[i - 1] == d[i - 1])
+        i--;
+    ok = ok && i > 0 && r[i - 1] < d[i - 1];
+    check(ok, limbs_name(what.c_str(), an, dn));
+}
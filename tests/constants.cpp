@@ -0,0 +1,87 @@
+/*
+    constants
+    ---------
+    The shared constant tables against values built from strings, their
+    bounds, and the O(1) sign queries and truth tests that use them.
+
+        g++ -std=c++14 -O2 tests/constants.cpp -o constants && ./constants
+*/
+
+#include "check.h"
+#include <stdexcept>
+
+template <class F>
+void check_out_of_range(F f, const std::string &what)
+{
+    bool thrown = false;
+    try
+    {
+        f();
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+    check(thrown, what + " does not throw out_of_range");
+}
+
+int main()
+{
+    // First used under an arena, the tables must not take its memory
+    {
+        BigIntArena arena;
+        {
+            BigIntAllocatorScope scope(arena);
+            bigint_power_of_ten(POWER_TABLE_SIZE - 1);
+            bigint_power_of_two(POWER_TABLE_SIZE - 1);
+            bigint_constant(SMALL_CONSTANT_LIMIT);
+        }
+        arena.reset();
+        BigIntAllocatorScope scope(arena);
+        BigInt overwrite = pow(BigInt(7), 30000);
+        overwrite += 1;
+    }
+
+    for (int i = -SMALL_CONSTANT_LIMIT; i <= SMALL_CONSTANT_LIMIT; i++)
+        check(bigint_constant(i) == BigInt(std::to_string(i)), "bigint_constant(" + std::to_string(i) + ")");
+    check(&bigint_constant(7) == &bigint_constant(7), "bigint_constant returns the same object");
+
+    std::string ten = "1";
+    BigInt two = 1;
+    for (size_t i = 0; i < POWER_TABLE_SIZE; i++, ten += "0", two += two)
+    {
+        check(bigint_power_of_ten(i) == BigInt(ten), "bigint_power_of_ten(" + std::to_string(i) + ")");
+        check(bigint_power_of_two(i) == two, "bigint_power_of_two(" + std::to_string(i) + ")");
+    }
+
+    check_out_of_range([] { bigint_constant(SMALL_CONSTANT_LIMIT + 1); }, "bigint_constant(limit + 1)");
+    check_out_of_range([] { bigint_constant(-SMALL_CONSTANT_LIMIT - 1); }, "bigint_constant(-limit - 1)");
+    check_out_of_range([] { bigint_power_of_ten(POWER_TABLE_SIZE); }, "bigint_power_of_ten(size)");
+    check_out_of_range([] { bigint_power_of_two(POWER_TABLE_SIZE); }, "bigint_power_of_two(size)");
+
+    // Sign queries, including zeros that came out of arithmetic
+    const BigInt zeros[] = {BigInt(), BigInt(0), BigInt("-0"), BigInt(5) - 5, -BigInt(0), BigInt(-3) * 0,
+                            (BigInt(1) << 200) - (BigInt(1) << 200)};
+    for (const BigInt &z : zeros)
+    {
+        check(z.is_zero() && !z.is_one() && z.sign() == 0 && z == 0, "zero " + z.to_string());
+        check(!z && !(z && 1) && (z || 1) && !(z || 0), "truth of zero");
+    }
+    const BigInt one = BigInt(10) / 10, minus_one = -one, big = BigInt(1) << 100;
+    check(one.is_one() && !one.is_zero() && one.sign() == 1, "one");
+    check(!minus_one.is_one() && minus_one.sign() == -1, "minus one");
+    check(!big.is_one() && big.sign() == 1 && (-big).sign() == -1 && !(big + 1).is_one(), "large values");
+    check(!!minus_one && (big && minus_one) && (BigInt(0) || big), "truth of non zero values");
+
+    // ++ and -- across zero and the limb boundaries
+    BigInt x = -2;
+    for (int i = -2; i <= 2; i++, ++x)
+        check(x == i && x.sign() == (i > 0) - (i < 0), "++ to " + std::to_string(i));
+    BigInt top = (BigInt(1) << 128) - 1;
+    check(++top == BigInt(1) << 128 && --top == (BigInt(1) << 128) - 1, "++ and -- at 2^128");
+    BigInt negative_top = -((BigInt(1) << 64) - 1);
+    check(--negative_top == -(BigInt(1) << 64) && ++negative_top == -((BigInt(1) << 64) - 1), "-- and ++ at -2^64");
+    check(x++ == 3 && x == 4 && x-- == 4 && x == 3, "postfix ++ and --");
+
+    return finish("constants");
+}
@@ -0,0 +1,77 @@
+/*
+    dc_division
+    -----------
+    The divide and conquer division against Knuth's Algorithm D, which must
+    give the same quotient and remainder limb for limb, with the threshold
+    forced low so that the recursion and its corrections run on small
+    blocks, partial blocks and unbalanced quotients.
+
+        g++ -std=c++14 -O2 tests/dc_division.cpp -o dc_division && ./dc_division
+*/
+
+#include "check.h"
+
+// divrem() at the threshold in force against divrem() with Knuth D only
+void check_dc(const Limbs &a, const Limbs &d, const char *what)
+{
+    size_t an = a.size(), dn = d.size(), qn = an - dn + 1;
+    Limbs q(qn), r(dn), expected_q(qn), expected_r(dn);
+    divrem(q.data(), r.data(), a.data(), an, d.data(), dn);
+
+    size_t threshold = DC_DIV_THRESHOLD;
+    DC_DIV_THRESHOLD = SIZE_MAX;
+    divrem(expected_q.data(), expected_r.data(), a.data(), an, d.data(), dn);
+    DC_DIV_THRESHOLD = threshold;
+
+    check(same_limbs(q, expected_q) && same_limbs(r, expected_r),
+          limbs_name(what, an, dn) + " at " + std::to_string(threshold));
+}
+
+// A divisor whose high limbs are all ones under a set top bit, so that the
+// estimated quotient blocks are often too large
+Limbs heavy_divisor(size_t dn)
+{
+    Limbs d = random_limbs(dn);
+    for (size_t i = dn / 2; i < dn; i++)
+        d[i] = ~(limb_t)0;
+    return d;
+}
+
+int main()
+{
+    ThresholdScope thresholds;
+
+    for (size_t threshold : {1, 2, 3, 5, 8})
+    {
+        DC_DIV_THRESHOLD = threshold;
+        for (size_t dn = 2; dn <= 30; dn++)
+        {
+            for (size_t an : {dn, dn + 1, dn + dn / 2, 2 * dn - 1, 2 * dn, 2 * dn + 1, 3 * dn + 2, 5 * dn})
+            {
+                check_dc(random_limbs(an), random_limbs(dn), "dc");
+                check_dc(Limbs(an, ~(limb_t)0), heavy_divisor(dn), "dc all ones");
+            }
+        }
+        check_divrem(random_limbs(700), random_limbs(250), "dc identity");
+    }
+
+    // With the multiplication tiers low as well, the corrections go
+    // through Karatsuba and Toom products
+    KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12, FFT_THRESHOLD = 40;
+    DC_DIV_THRESHOLD = 4;
+    for (size_t dn : {9, 33, 100, 257})
+    {
+        check_dc(random_limbs(3 * dn + 7), random_limbs(dn), "dc over fast products");
+        check_dc(Limbs(2 * dn, ~(limb_t)0), heavy_divisor(dn), "dc over fast products, all ones");
+    }
+
+    // The operators take the same path
+    for (int i = 0; i < 30; i++)
+    {
+        BigInt a = random_bigint(10 + test_rng()() % 200), b = random_bigint(3 + test_rng()() % 60);
+        BigInt q = a / b, r = a % b;
+        check(q * b + r == a && (r < 0 ? -r : r) < (b < 0 ? -b : b), "BigInt / and %");
+    }
+
+    return finish("dc_division");
+}
@@ -0,0 +1,98 @@
+/*
+    division
+    --------
+    Knuth's Algorithm D, checked through q * d + r == a with r < d on
+    random operands and on the divisors that drive the quotient digit
+    estimate and its corrections, and the signs of / and % against the
+    native integers.
+
+        g++ -std=c++14 -O2 tests/division.cpp -o division && ./division
+*/
+
+#include "check.h"
+#include <climits>
+
+int main()
+{
+    ThresholdScope thresholds;
+    DC_DIV_THRESHOLD = SIZE_MAX;
+
+    for (size_t dn = 1; dn <= 12; dn++)
+    {
+        for (size_t an = dn; an <= dn + 12; an++)
+            check_divrem(random_limbs(an), random_limbs(dn), "knuth");
+    }
+    check_divrem(random_limbs(300), random_limbs(120), "knuth");
+
+    // Divisors with the top bit set (no normalizing shift), with only the
+    // lowest bit of the top limb set (the largest shift), all ones, and a
+    // power of the base with a one below it
+    for (size_t dn = 1; dn <= 6; dn++)
+    {
+        Limbs top(dn, 0), low(dn, ~(limb_t)0), ones(dn, ~(limb_t)0), step(dn, 0);
+        top[dn - 1] = (limb_t)1 << 63;
+        low[dn - 1] = 1;
+        step[dn - 1] = 1, step[0] |= 1;
+        for (const Limbs &d : {top, low, ones, step})
+        {
+            for (size_t an = dn; an <= dn + 4; an++)
+            {
+                check_divrem(random_limbs(an), d, "knuth edge divisor");
+                check_divrem(Limbs(an, ~(limb_t)0), d, "knuth edge divisor, all ones");
+            }
+        }
+    }
+
+    // a = d * q - 1 for a q whose digits come out of a q-hat that is one
+    // or two too large
+    for (int i = 0; i < 200; i++)
+    {
+        size_t dn = 2 + test_rng()() % 5, qn = 1 + test_rng()() % 4;
+        Limbs d = random_limbs(dn), q(qn, ~(limb_t)0), a(dn + qn);
+        d[dn - 1] |= (limb_t)1 << 63;
+        d[dn - 2] = ~(limb_t)0;
+        mul_basecase(a.data(), d.data(), dn, q.data(), qn);
+        sub_1(a.data(), a.data(), dn + qn, 1);
+        check_divrem(a, d, "knuth q-hat correction");
+    }
+
+    // B^dn by 2^63 * B^(dn-1) + low: the top limbs give q-hat = 2 with no
+    // remainder and a zero second limb passes it, so only the add back
+    // step finds it one too large
+    for (size_t dn = 3; dn <= 8; dn++)
+    {
+        Limbs d = random_limbs(dn), a(dn + 1, 0);
+        d[dn - 1] = (limb_t)1 << 63;
+        d[dn - 2] = 0;
+        d[0] |= 1;
+        a[dn] = 1;
+        check_divrem(a, d, "knuth add back");
+    }
+
+    // Signs of the quotient and the remainder follow the native operators
+    const long long values[] = {0, 1, -1, 2, -2, 7, -7, 1000000007, -999999999989, LLONG_MAX, LLONG_MIN + 1};
+    for (long long x : values)
+    {
+        for (long long y : values)
+        {
+            if (y == 0)
+                continue;
+            BigInt a = x, b = y;
+            std::string pair = std::to_string(x) + ", " + std::to_string(y);
+            check(a / b == x / y && a % b == x % y, "/ and % " + pair);
+            std::pair<BigInt, BigInt> qr = a.divmod(b);
+            check(qr.first == x / y && qr.second == x % y, "divmod " + pair);
+        }
+    }
+
+    // Multi-limb operands keep the same rules
+    for (int i = 0; i < 100; i++)
+    {
+        BigInt a = random_bigint(1 + test_rng()() % 10), b = random_bigint(1 + test_rng()() % 6);
+        BigInt q = a / b, r = a % b;
+        check(q * b + r == a, "q * b + r == a");
+        check((r == 0 || (r < 0) == (a < 0)) && (r < 0 ? -r : r) < (b < 0 ? -b : b), "remainder of a / b");
+    }
+
+    return finish("division");
+}
@@ -0,0 +1,94 @@
+/*
+    fixed
+    -----
+    FixedBigInt at compile time, through static_assert on its constexpr
+    arithmetic, length() and digits, and at run time against BigInt, with
+    every result that does not fit throwing.
+
+        g++ -std=c++14 -O2 tests/fixed.cpp -o fixed && ./fixed
+*/
+
+#include "check.h"
+#include <stdexcept>
+
+typedef FixedBigInt<128> Int128;
+typedef FixedBigInt<256> Int256;
+
+constexpr Int256 factorial(int n)
+{
+    Int256 result = 1;
+    for (int i = 2; i <= n; i++)
+        result *= i;
+    return result;
+}
+
+constexpr Int256 k = Int256(1) << 200;
+constexpr Int256 f30 = factorial(30); // 265252859812191058636308480000000
+
+static_assert((k >> 200) == 1 && (k >> 201) == 0 && k > f30, "FixedBigInt shifts");
+static_assert(Int256(12345) * 678 == 8369910 && Int256(-12345) * 678 == -8369910, "FixedBigInt *");
+static_assert(Int256(-7) / 2 == -3 && Int256(-7) % 2 == -1 && Int256(7) % -2 == 1, "FixedBigInt / and % signs");
+static_assert(k % 1000000007 == 499445072 && (k + 12345) % 1000000007 == 499457417, "FixedBigInt %");
+static_assert(k / 1000000007 * 1000000007 + k % 1000000007 == k, "FixedBigInt /");
+static_assert(k - k == 0 && -(k - 1) + k == 1 && (-k).sign() == -1 && (k - k).is_zero(), "FixedBigInt + and -");
+static_assert(f30 / factorial(28) == 870 && f30 % factorial(29) == 0, "FixedBigInt multi-limb division");
+static_assert(Int256(Int128(-5)) == -5, "FixedBigInt widening");
+
+static_assert(Int256(0).length() == 1 && Int256(-9).length() == 1 && Int256(10).length() == 2, "FixedBigInt length");
+static_assert(f30.length() == 33 && k.length() == 61, "FixedBigInt length");
+static_assert(f30[0] == 2 && f30[1] == 6 && f30[4] == 5 && f30[32] == 0, "FixedBigInt digits");
+static_assert(k[0] == 1 && k[1] == 6 && k[60] == 6, "FixedBigInt digits");
+static_assert(Int256(-1234567890123456789LL)[18] == 9, "FixedBigInt digits");
+
+// Checks that f throws E
+template <class E, class F>
+void check_throws(F f, const std::string &what)
+{
+    bool thrown = false;
+    try
+    {
+        f();
+    }
+    catch (const E &)
+    {
+        thrown = true;
+    }
+    check(thrown, what + " does not throw");
+}
+
+int main()
+{
+    // Against BigInt on random values that leave room for the results
+    for (int i = 0; i < 300; i++)
+    {
+        BigInt a = random_bigint(test_rng()() % 3), b = random_bigint(test_rng()() % 3);
+        Int256 x(a), y(b);
+        std::string pair = a.to_string() + ", " + b.to_string();
+        check(BigInt(x + y) == a + b && BigInt(x - y) == a - b && BigInt(x * y) == a * b, "+ - * " + pair);
+        if (b != 0)
+            check(BigInt(x / y) == a / b && BigInt(x % y) == a % b, "/ % " + pair);
+        check((x < y) == (a < b) && (x == y) == (a == b), "compare " + pair);
+        check(BigInt(x << 61) == a << 61 && BigInt(x >> 70) == a >> 70, "shifts " + pair);
+        check(x.to_string() == a.to_string() && x.length() == a.length(), "to_string and length " + pair);
+        for (int d = 0; d < x.length(); d += 7)
+            check(BigInt(x[d]) == a[d], "digit " + std::to_string(d) + " of " + a.to_string());
+    }
+
+    // Results that do not fit
+    const Int128 max = Int128((BigInt(1) << 128) - 1);
+    check(max.length() == 39 && max.to_string() == "340282366920938463463374607431768211455", "largest Int128");
+    check_throws<std::overflow_error>([&] { return max + 1; }, "max + 1");
+    check_throws<std::overflow_error>([&] { return -max - 1; }, "-max - 1");
+    check_throws<std::overflow_error>([&] { return Int128(1LL << 62) * Int128(1LL << 62) * Int128(1LL << 62); }, "2^186");
+    check_throws<std::overflow_error>([&] { return Int128(3) << 127; }, "3 << 127");
+    check_throws<std::overflow_error>([&] { return Int128(1) << 128; }, "1 << 128");
+    check_throws<std::overflow_error>([&] { return Int128(k); }, "narrowing 2^200");
+    check_throws<std::out_of_range>([&] { return Int128(BigInt(1) << 128); }, "BigInt 2^128");
+    check(Int128(1) << 127 == Int128(Int256(1) << 127), "1 << 127");
+
+    // Mixed with BigInt the result is a BigInt
+    BigInt big = BigInt(1) << 300;
+    check(big + k == big + (BigInt(1) << 200) && k * big == BigInt(1) << 500, "mixed arithmetic");
+
+    return finish("fixed");
+}
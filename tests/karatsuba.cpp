@@ -0,0 +1,46 @@
+/*
+    karatsuba
+    ---------
+    Karatsuba multiplication against the schoolbook product, with the
+    threshold forced low so that the recursion reaches small, odd and
+    unbalanced splits.
+
+        g++ -std=c++14 -O2 tests/karatsuba.cpp -o karatsuba && ./karatsuba
+*/
+
+#include "check.h"
+
+int main()
+{
+    ThresholdScope thresholds;
+    TOOM3_THRESHOLD = TOOM4_THRESHOLD = FFT_THRESHOLD = SIZE_MAX;
+
+    for (size_t threshold : {2, 3, 4, 7, 16})
+    {
+        KARATSUBA_THRESHOLD = threshold;
+        for (size_t an = 1; an <= 70; an++)
+        {
+            // balanced, just above and below half, and very unbalanced
+            for (size_t bn : {an, an - an / 3, (an + 1) / 2 + 1, (an + 1) / 2, (size_t)1})
+                if (bn >= 1 && bn <= an)
+                    check_mul(an, bn, "karatsuba");
+        }
+        check_mul(300, 257, "karatsuba");
+        check_mul(1000, 130, "karatsuba");
+    }
+
+    // The public operator against shift and add
+    KARATSUBA_THRESHOLD = 2;
+    for (int i = 0; i < 50; i++)
+    {
+        BigInt a = random_bigint(1 + test_rng()() % 40), b = random_bigint(1 + test_rng()() % 40);
+        BigInt product = a * b;
+        BigInt expected = 0;
+        for (BigInt d = b < 0 ? -b : b, place = a; d != 0; d >>= 1, place <<= 1)
+            if (d % 2 != 0)
+                expected += place;
+        check(product == (b < 0 ? -expected : expected), "BigInt * BigInt");
+    }
+
+    return finish("karatsuba");
+}
@@ -0,0 +1,111 @@
+/*
+    lazy
+    ----
+    Expressions started with lazy() against the same arithmetic done
+    eagerly, with the target among the operands, across the multiplication
+    tiers, and with the fused forms allocating the same whichever side the
+    product is on.
+
+        g++ -std=c++14 -O2 tests/lazy.cpp -o lazy && ./lazy
+*/
+
+#include "check.h"
+
+void check_expressions(const BigInt &a, const BigInt &b, const BigInt &c, const BigInt &m, const std::string &what)
+{
+    BigInt t;
+    t = lazy(a) * b + c;
+    check(t == a * b + c, "a * b + c, " + what);
+    t = c + lazy(a) * b;
+    check(t == a * b + c, "c + a * b, " + what);
+    t = lazy(a) * b - c;
+    check(t == a * b - c, "a * b - c, " + what);
+    t = c - lazy(a) * b;
+    check(t == c - a * b, "c - a * b, " + what);
+    t = lazy(a) * a;
+    check(t == a * a, "a * a, " + what);
+    t = (lazy(a) + b) * c - 7;
+    check(t == (a + b) * c - 7, "(a + b) * c - 7, " + what);
+    t = 5 - lazy(a) * b;
+    check(t == 5 - a * b, "5 - a * b, " + what);
+    if (m != 0)
+    {
+        t = lazy(a) * b % m;
+        check(t == a * b % m, "a * b % m, " + what);
+        t = lazy(a) * b % m + c;
+        check(t == a * b % m + c, "a * b % m + c, " + what);
+    }
+
+    t = c;
+    t += lazy(a) * b;
+    check(t == c + a * b, "+= a * b, " + what);
+    t = c;
+    t -= lazy(a) * b;
+    check(t == c - a * b, "-= a * b, " + what);
+
+    BigInt built = lazy(a) * b + c;
+    check(built == a * b + c, "BigInt(a * b + c), " + what);
+
+    // the target is an operand
+    t = a;
+    t = lazy(t) * b + t;
+    check(t == a * b + a, "t = t * b + t, " + what);
+    t = b;
+    t = c - lazy(a) * t;
+    check(t == c - a * b, "t = c - a * t, " + what);
+    t = a;
+    t = lazy(t) * t + c;
+    check(t == a * a + c, "t = t * t + c, " + what);
+    t = a;
+    t += lazy(t) * t;
+    check(t == a + a * a, "t += t * t, " + what);
+}
+
+int main()
+{
+    const size_t sizes[] = {0, 1, 2, 3, 20, 90};
+    for (size_t an : sizes)
+    {
+        for (size_t bn : sizes)
+        {
+            for (size_t cn : {0, 1, 4, 200})
+            {
+                BigInt a = random_bigint(an), b = random_bigint(bn), c = random_bigint(cn), m = random_bigint(1 + cn / 2);
+                check_expressions(a, b, c, m, limbs_name("sizes", an, bn) + "+" + std::to_string(cn));
+            }
+        }
+    }
+
+    {
+        ThresholdScope thresholds;
+        KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12, FFT_THRESHOLD = 40;
+        for (size_t n : {7, 30, 100})
+            check_expressions(random_bigint(n), random_bigint(n - 3), random_bigint(2 * n), random_bigint(n), "low thresholds");
+    }
+
+    // a * b + c and c + a * b take the same fused path, so into equal
+    // targets they allocate the same
+    for (int i = 0; i < 300; i++)
+    {
+        BigInt a = random_bigint(1 + test_rng()() % 50), b = random_bigint(1 + test_rng()() % 50);
+        BigInt c = random_bigint(test_rng()() % 100), target = random_bigint(test_rng()() % 100);
+        size_t allocations[2];
+        for (int order = 0; order < 2; order++)
+        {
+            BigInt t = target;
+            CountingAllocator counter;
+            {
+                BigIntAllocatorScope scope(counter);
+                if (order == 0)
+                    t = lazy(a) * b + c;
+                else
+                    t = c + lazy(a) * b;
+            }
+            allocations[order] = counter.allocations;
+        }
+        check(allocations[0] == allocations[1], "a * b + c and c + a * b allocate " + std::to_string(allocations[0]) +
+                                                    " and " + std::to_string(allocations[1]));
+    }
+
+    return finish("lazy");
+}
@@ -0,0 +1,51 @@
+/*
+    literals
+    --------
+    _fixed literals through static_assert, with the width they pick, and
+    _big literals against the same digits read from a string, in every base
+    and with separators.
+
+        g++ -std=c++14 -O2 tests/literals.cpp -o literals && ./literals
+*/
+
+#include "check.h"
+#include <type_traits>
+
+static_assert(0_fixed == 0 && 1_fixed == 1 && 1'000_fixed == 1000, "_fixed small values");
+static_assert(FixedBigInt<128>(18446744073709551615_fixed) == (FixedBigInt<128>(1) << 64) - 1, "_fixed 2^64 - 1");
+static_assert(18446744073709551616_fixed == FixedBigInt<128>(1) << 64, "_fixed 2^64");
+static_assert(0xffffffffffffffffffffffffffffffff_fixed == (FixedBigInt<192>(1) << 128) - 1, "_fixed hex");
+static_assert(0b1000000000000000000000000000000000000000000000000000000000000000000000_fixed == FixedBigInt<128>(1) << 69,
+              "_fixed binary");
+static_assert(0777_fixed == 511 && 0'7'7_fixed == 63 && 0_fixed == 00_fixed, "_fixed octal");
+static_assert(1'000'000'000'000'000'000'000_fixed == FixedBigInt<128>(1000000000000LL) * 1000000000, "_fixed separators");
+static_assert(0xDead'Beef_fixed == 0xdeadbeef && 0XAB_fixed == 0xab && 0B101_fixed == 5, "_fixed prefixes and case");
+
+// the smallest width that holds the value
+static_assert(std::is_same<decltype(18446744073709551615_fixed), FixedBigInt<64> >::value, "_fixed width");
+static_assert(std::is_same<decltype(18446744073709551616_fixed), FixedBigInt<128> >::value, "_fixed width");
+static_assert(std::is_same<decltype(0x1'0000'0000'0000'0000'0000'0000'0000'0000_fixed), FixedBigInt<192> >::value,
+              "_fixed width");
+
+int main()
+{
+    check(0_big == 0 && 1_big == 1 && -5_big == -5, "small _big");
+    check(9876543210123456789098765432101234567890_big == BigInt("9876543210123456789098765432101234567890"), "decimal _big");
+    check(1'000'000'000'000'000'000'000_big == BigInt("1000000000000000000000"), "_big with separators");
+    check(0xffffffffffffffffffffffffffffffff_big == BigInt("340282366920938463463374607431768211455"), "hex _big");
+    check(0xFFFF'ffff'FFFF'ffff'0000'0000'0000'0001_big == (BigInt(1) << 128) - (BigInt(1) << 64) + 1, "mixed case hex _big");
+    check(0b1111111111111111111111111111111111111111111111111111111111111111111111_big ==
+              BigInt("1180591620717411303423"),
+          "binary _big");
+    check(07777777777777777777777777_big == BigInt("37778931862957161709567"), "octal _big");
+    check(18446744073709551616_big == BigInt(1) << 64, "2^64 _big");
+
+    // a long literal against its string
+    check(1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890_big ==
+              BigInt("1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890"),
+          "100 digit _big");
+    check(BigInt(0x123456789abcdef0123456789abcdef0123456789abcdef_fixed) == 0x123456789abcdef0123456789abcdef0123456789abcdef_big,
+          "_fixed and _big agree");
+
+    return finish("literals");
+}
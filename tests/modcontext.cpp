@@ -0,0 +1,96 @@
+/*
+    modcontext
+    ----------
+    ModContext operations against % on the same values, for odd and even
+    moduli of 1 to 40 limbs, with inputs that are negative or many times
+    wider than the modulus. Barrett reduction takes a basecase branch
+    below KARATSUBA_THRESHOLD and a fast product branch above it, so the
+    threshold is set low and high to run both on every size.
+
+        g++ -std=c++14 -O2 tests/modcontext.cpp -o modcontext && ./modcontext
+*/
+
+#include "check.h"
+#include <stdexcept>
+
+BigInt floor_mod(const BigInt &x, const BigInt &mod)
+{
+    BigInt m = mod < 0 ? -mod : mod;
+    BigInt r = x % m;
+    return r < 0 ? r + m : r;
+}
+
+struct Case
+{
+    BigInt mod, a, b, wide, exponent;
+    BigInt reduced, wide_reduced, sum, difference, product, square, power;
+};
+
+int main()
+{
+    std::vector<Case> cases;
+    for (size_t n : {1, 2, 3, 5, 16, 30, 31, 32, 33, 40})
+    {
+        for (int shape = 0; shape < 3; shape++)
+        {
+            Case c;
+            c.mod = random_bigint(n);
+            if (shape == 1 && c.mod % 2 != 0)
+                c.mod += 1;
+            c.a = random_bigint(n);
+            c.b = random_bigint(shape == 2 ? 2 * n : n - n / 2);
+            c.wide = random_bigint(5 * n + 1);
+            c.exponent = random_bigint(1, false);
+
+            c.reduced = floor_mod(c.a, c.mod);
+            c.wide_reduced = floor_mod(c.wide, c.mod);
+            c.sum = floor_mod(c.a + c.b, c.mod);
+            c.difference = floor_mod(c.a - c.b, c.mod);
+            c.product = floor_mod(c.a * c.b, c.mod);
+            c.square = floor_mod(c.wide * c.wide, c.mod);
+            c.power = powmod(c.a, c.exponent, c.mod);
+            cases.push_back(c);
+        }
+    }
+
+    for (size_t karatsuba : {KARATSUBA_THRESHOLD, (size_t)2, SIZE_MAX})
+    {
+        ThresholdScope thresholds;
+        KARATSUBA_THRESHOLD = karatsuba;
+        for (const Case &c : cases)
+        {
+            const ModContext context(c.mod);
+            std::string what = std::to_string(bit_length(c.mod)) + " bit modulus, Karatsuba at " + std::to_string(karatsuba);
+            check(context.modulus() == (c.mod < 0 ? -c.mod : c.mod), "modulus of " + what);
+            check(context.reduce(c.a) == c.reduced && context.reduce(c.wide) == c.wide_reduced &&
+                      context.reduce(-c.wide) == floor_mod(-c.wide, c.mod),
+                  "reduce, " + what);
+            check(context.addmod(c.a, c.b) == c.sum, "addmod, " + what);
+            check(context.submod(c.a, c.b) == c.difference, "submod, " + what);
+            check(context.mulmod(c.a, c.b) == c.product, "mulmod, " + what);
+            check(context.mulmod(c.reduced, c.reduced) == context.sqrmod(c.a), "mulmod of reduced values, " + what);
+            check(context.sqrmod(c.wide) == c.square, "sqrmod, " + what);
+            check(context.powmod(c.a, c.exponent) == c.power, "powmod, " + what);
+        }
+    }
+
+    // invmod: an inverse when there is one, domain_error otherwise
+    for (const Case &c : cases)
+    {
+        const ModContext context(c.mod);
+        BigInt g = gcd(c.a, c.mod);
+        bool thrown = false;
+        try
+        {
+            BigInt inverse = context.invmod(c.a);
+            check(g == 1 && floor_mod(c.a * inverse, c.mod) == 1 % context.modulus(), "invmod of " + c.a.to_string());
+        }
+        catch (const std::domain_error &)
+        {
+            thrown = true;
+        }
+        check(thrown == (g != 1), "invmod throws only without an inverse");
+    }
+
+    return finish("modcontext");
+}
@@ -0,0 +1,77 @@
+/*
+    moves
+    -----
+    The rvalue overloads must give the same results as the lvalue ones and
+    build them in the buffer of the expiring operand, and a moved from
+    BigInt must stay usable.
+
+        g++ -std=c++14 -O2 tests/moves.cpp -o moves && ./moves
+*/
+
+#include "check.h"
+
+int main()
+{
+    std::vector<BigInt> values = {0, 1, -1, BigInt(1) << 64, -(BigInt(1) << 128)};
+    for (size_t n : {1, 2, 3, 10, 70, 200})
+        values.push_back(random_bigint(n));
+
+    for (const BigInt &a : values)
+    {
+        for (const BigInt &b : values)
+        {
+            const BigInt sum = a + b, difference = a - b;
+            std::string pair = a.to_string().substr(0, 20) + ", " + b.to_string().substr(0, 20);
+
+            BigInt x = a, y = b;
+            check(std::move(x) + b == sum, "rvalue + lvalue " + pair);
+            x = a;
+            check(a + std::move(y) == sum, "lvalue + rvalue " + pair);
+            x = a, y = b;
+            check(std::move(x) + std::move(y) == sum, "rvalue + rvalue " + pair);
+
+            x = a, y = b;
+            check(std::move(x) - b == difference, "rvalue - lvalue " + pair);
+            y = b;
+            check(a - std::move(y) == difference, "lvalue - rvalue " + pair);
+            x = a, y = b;
+            check(std::move(x) - std::move(y) == difference, "rvalue - rvalue " + pair);
+
+            x = a;
+            check(-std::move(x) == -a, "-rvalue " + pair);
+            check(BigInt(a) * b == a * b && BigInt(a) / 7 == a / 7, "rvalue * and / " + pair);
+
+            // temporaries compare without copies
+            check((a + 0 < b + 0) == (a < b) && (a + 0 == b - 0) == (a == b), "compare temporaries " + pair);
+        }
+    }
+
+    // A moved from value can be assigned, read and used again
+    for (const BigInt &a : values)
+    {
+        BigInt x = a, y(std::move(x));
+        check(y == a, "move construction");
+        x = 5;
+        check(x + 1 == 6, "reuse after move construction");
+
+        BigInt z = a;
+        x = std::move(z);
+        check(x == a, "move assignment");
+        z += a;
+        check(z == a && z.to_string() == a.to_string(), "reuse after move assignment");
+    }
+
+    // A temporary operand with room for the result lends its buffer
+    BigInt big = (BigInt(1) << 5000) + 12345, small = 987654321;
+    BigInt chain = big + small;
+    CountingAllocator counter;
+    {
+        BigIntAllocatorScope scope(counter);
+        for (int i = 0; i < 100; i++)
+            chain = std::move(chain) + small - big + big;
+    }
+    check(counter.allocations == 0, "rvalue operations allocate: " + std::to_string(counter.allocations));
+    check(chain == big + small * 101, "chain of rvalue operations");
+
+    return finish("moves");
+}
@@ -0,0 +1,58 @@
+/*
+    ntt
+    ---
+    The number theoretic transform product against the schoolbook product,
+    with the threshold forced low so that tiny and odd sized transforms
+    run, and on all ones operands, whose convolution coefficients come
+    closest to the bound the three primes can rebuild.
+
+        g++ -std=c++14 -O2 tests/ntt.cpp -o ntt && ./ntt
+*/
+
+#include "check.h"
+
+// mul_fft() straight, on a and b, against mul_basecase()
+void check_fft(const Limbs &a, const Limbs &b, const char *what)
+{
+    size_t an = a.size(), bn = b.size();
+    Limbs r(an + bn), expected(an + bn);
+    mul_fft(r.data(), a.data(), an, b.data(), bn);
+    mul_basecase(expected.data(), a.data(), an, b.data(), bn);
+    check(same_limbs(r, expected), limbs_name(what, an, bn));
+}
+
+int main()
+{
+    ThresholdScope thresholds;
+
+    // Every size up to a few transform lengths, through mul()
+    for (size_t threshold : {2, 3, 5})
+    {
+        KARATSUBA_THRESHOLD = TOOM3_THRESHOLD = TOOM4_THRESHOLD = FFT_THRESHOLD = threshold;
+        for (size_t an = 1; an <= 40; an++)
+        {
+            for (size_t bn = 1; bn <= an; bn += 1 + bn / 4)
+                check_mul(an, bn, "ntt");
+        }
+    }
+
+    // The kernel itself, from one limb up, including squares
+    for (size_t an = 1; an <= 70; an++)
+    {
+        Limbs a = random_limbs(an);
+        check_fft(a, random_limbs(1 + an / 2), "mul_fft");
+        check_fft(a, a, "mul_fft square");
+    }
+
+    // All ones operands and large, unbalanced transforms
+    for (size_t n : {1, 2, 63, 64, 65, 1000, 3000})
+    {
+        Limbs ones(n, ~(limb_t)0);
+        check_fft(ones, ones, "mul_fft all ones");
+        check_fft(ones, Limbs(1 + n / 3, ~(limb_t)0), "mul_fft all ones");
+    }
+    check_fft(random_limbs(4000), random_limbs(2500), "mul_fft");
+    check_fft(random_limbs(5000), random_limbs(7), "mul_fft");
+
+    return finish("ntt");
+}
@@ -0,0 +1,81 @@
+/*
+    pow
+    ---
+    pow() against repeated multiplication, at the default thresholds and
+    with every multiplication tier forced low, and the bases whose odd part
+    is 1 (+-1 and the powers of two), which must not size the result by the
+    exponent.
+
+        g++ -std=c++14 -O2 tests/pow.cpp -o pow && ./pow
+*/
+
+#include "check.h"
+#include <chrono>
+
+// Runs f and checks that it took less than a tenth of a second
+template <class F>
+void check_fast(F f, const std::string &what)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    check(seconds < 0.1, what + " is slow");
+}
+
+int main()
+{
+    const unsigned long long huge = 1ULL << 40;
+
+    check_fast([] { check(pow(BigInt(-1), 1ULL << 40) == 1, "pow(-1, 2^40)"); }, "pow(-1, 2^40)");
+    check_fast([] { check(pow(BigInt(-1), (1ULL << 40) + 1) == -1, "pow(-1, 2^40 + 1)"); }, "pow(-1, 2^40 + 1)");
+    check_fast([=] { check(pow(BigInt(1), huge) == 1, "pow(1, 2^40)"); }, "pow(1, 2^40)");
+    check_fast([] { check(pow(BigInt(-1), 100000000) == 1, "pow(-1, 10^8)"); }, "pow(-1, 10^8)");
+
+    for (unsigned long long e : {1ULL, 63ULL, 64ULL, 65ULL, 1000ULL, 1000000ULL})
+    {
+        BigInt expected = BigInt(1) << e;
+        check_fast([&] { check(pow(BigInt(2), e) == expected, "pow(2, " + std::to_string(e) + ")"); },
+                   "pow(2, " + std::to_string(e) + ")");
+        check(pow(BigInt(-4), e) == (e % 2 ? -(expected * expected) : expected * expected),
+              "pow(-4, " + std::to_string(e) + ")");
+    }
+
+    // Odd and even bases against repeated products, across the
+    // multiplication tiers
+    for (long long base : {3LL, -3LL, 6LL, 10LL, 255LL, -1000000007LL})
+    {
+        BigInt expected = 1;
+        for (unsigned long long e = 0; e <= 600; e++)
+        {
+            if (e % 37 == 0 || e < 10)
+                check(pow(BigInt(base), e) == expected, "pow(" + std::to_string(base) + ", " + std::to_string(e) + ")");
+            expected *= base;
+        }
+    }
+    BigInt big = pow(BigInt(3), 5000) - 1, expected = 1;
+    for (int e = 0; e <= 12; e++, expected *= big)
+        check(pow(big, e) == expected, "pow(3^5000 - 1, " + std::to_string(e) + ")");
+
+    // The same products through every multiplication tier, against powers
+    // built at the default thresholds
+    std::vector<BigInt> bases, powers;
+    for (size_t n : {1, 2, 3, 9})
+    {
+        bases.push_back(random_bigint(n));
+        expected = 1;
+        for (int e = 0; e <= 40; e++, expected *= bases.back())
+            powers.push_back(expected);
+    }
+    BigInt shifted = pow(BigInt(3), 100) << 7000;
+
+    ThresholdScope thresholds;
+    KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12, FFT_THRESHOLD = 40;
+    for (size_t i = 0; i < bases.size(); i++)
+    {
+        for (int e = 0; e <= 40; e++)
+            check(pow(bases[i], e) == powers[41 * i + e], "pow(base " + std::to_string(i) + ", " + std::to_string(e) + ") at low thresholds");
+    }
+    check(pow(BigInt(3) << 70, 100) == shifted, "pow(3 * 2^70, 100) at low thresholds");
+
+    return finish("pow");
+}
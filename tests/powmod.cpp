@@ -0,0 +1,117 @@
+/*
+    powmod
+    ------
+    powmod() against square and multiply with %, for odd (Montgomery) and
+    even moduli of every size up to a few windows, for every sign of base
+    and modulus, with more moduli in turn than the per thread cache holds,
+    and with the multiplication tiers forced low.
+
+        g++ -std=c++14 -O2 tests/powmod.cpp -o powmod && ./powmod
+*/
+
+#include "check.h"
+#include <stdexcept>
+
+// base^exponent mod |mod| in [0, |mod|), one bit of the exponent at a time
+BigInt naive_powmod(const BigInt &base, const BigInt &exponent, const BigInt &mod)
+{
+    BigInt m = mod < 0 ? -mod : mod;
+    BigInt result = 1 % m, square = (base % m + m) % m;
+    for (BigInt e = exponent; e != 0; e >>= 1)
+    {
+        if (e % 2 != 0)
+            result = result * square % m;
+        square = square * square % m;
+    }
+    return result;
+}
+
+void check_powmod(const BigInt &base, const BigInt &exponent, const BigInt &mod, const std::string &what)
+{
+    check(powmod(base, exponent, mod) == naive_powmod(base, exponent, mod), what);
+}
+
+int main()
+{
+    for (size_t n = 1; n <= 20; n++)
+    {
+        for (bool odd : {true, false})
+        {
+            BigInt mod = random_bigint(n);
+            if ((mod % 2 != 0) != odd)
+                mod += 1;
+            std::string what = std::string(odd ? "odd" : "even") + " modulus of " + std::to_string(n) + " limbs";
+
+            check_powmod(random_bigint(n), random_bigint(1 + n % 3, false), mod, what);
+            check_powmod(random_bigint(2 * n + 1), random_bigint(1, false), mod, what + ", base above it");
+            check_powmod(-random_bigint(n, false), 65537, mod, what + ", negative base");
+            check_powmod(random_bigint(n), 0, mod, what + ", exponent 0");
+            check_powmod(random_bigint(n), 1, mod, what + ", exponent 1");
+            check_powmod(0, random_bigint(1, false), mod, what + ", base 0");
+            check_powmod(mod - 1, (BigInt(1) << 64) + 1, mod, what + ", base -1");
+        }
+    }
+
+    for (long long mod : {1LL, -1LL, 2LL, -2LL, 3LL, -7LL, 1000000007LL, -1000000007LL})
+    {
+        for (long long base : {0LL, 1LL, -1LL, 2LL, -5LL, 123456789LL})
+        {
+            for (long long exponent : {0LL, 1LL, 2LL, 3LL, 64LL, 1000000LL})
+                check_powmod(base, exponent, mod, "powmod(" + std::to_string(base) + ", " + std::to_string(exponent) + ", " +
+                                                      std::to_string(mod) + ")");
+        }
+    }
+
+    // Several moduli in turn evict each other from the cache
+    std::vector<BigInt> moduli, bases;
+    for (int i = 0; i < 7; i++)
+    {
+        moduli.push_back(random_bigint(4 + i));
+        bases.push_back(random_bigint(3));
+    }
+    BigInt exponent = random_bigint(2, false);
+    std::vector<BigInt> expected;
+    for (int i = 0; i < 7; i++)
+        expected.push_back(naive_powmod(bases[i], exponent, moduli[i]));
+    for (int round = 0; round < 4; round++)
+    {
+        for (int i = 0; i < 7; i += 1 + round % 2)
+            check(powmod(bases[i], exponent, moduli[i]) == expected[i], "cached modulus " + std::to_string(i));
+        check(powmod(bases[0], exponent, moduli[0]) == expected[0], "most recent modulus");
+    }
+
+    // Every multiplication tier under the reductions, against results at
+    // the default thresholds
+    std::vector<BigInt> cases, results;
+    for (size_t n : {3, 8, 30})
+    {
+        BigInt odd = random_bigint(n, false), base = random_bigint(n), e = random_bigint(1, false);
+        if (odd % 2 == 0)
+            odd += 1;
+        for (const BigInt &mod : {odd, odd + 1})
+        {
+            cases.insert(cases.end(), {base, e, mod});
+            results.push_back(naive_powmod(base, e, mod));
+        }
+    }
+    {
+        ThresholdScope thresholds;
+        KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12, FFT_THRESHOLD = 40;
+        for (size_t i = 0; i < results.size(); i++)
+            check(powmod(cases[3 * i], cases[3 * i + 1], cases[3 * i + 2]) == results[i],
+                  std::string(i % 2 ? "even" : "odd") + " modulus at low thresholds");
+    }
+
+    bool thrown = false;
+    try
+    {
+        powmod(2, -1, 7);
+    }
+    catch (const std::domain_error &)
+    {
+        thrown = true;
+    }
+    check(thrown, "negative exponent does not throw domain_error");
+
+    return finish("powmod");
+}
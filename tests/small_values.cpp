@@ -0,0 +1,85 @@
+/*
+    small_values
+    ------------
+    Values of up to 128 bits live inside the BigInt and use native 128-bit
+    arithmetic: the results must match __int128 and the operations must not
+    allocate.
+
+        g++ -std=c++14 -O2 tests/small_values.cpp -o small_values && ./small_values
+*/
+
+#include "check.h"
+
+typedef __int128 int128;
+
+std::string int128_string(int128 x)
+{
+    if (x == 0)
+        return "0";
+    bool negative = x < 0;
+    unsigned __int128 m = negative ? 0 - (unsigned __int128)x : (unsigned __int128)x;
+    std::string digits;
+    for (; m; m /= 10)
+        digits.insert(digits.begin(), char('0' + (int)(m % 10)));
+    return negative ? "-" + digits : digits;
+}
+
+BigInt from_int128(int128 x)
+{
+    return BigInt(int128_string(x));
+}
+
+int main()
+{
+    // Boundaries of one and two limbs, and random values below 2^62 so that
+    // every sum, difference and product fits in an int128
+    std::vector<int128> values = {0, 1, -1, 2, -2, (int128)1 << 62, -((int128)1 << 62),
+                                  (int128)1 << 61, 1000000007, -999999999989LL};
+    for (int i = 0; i < 40; i++)
+        values.push_back((int128)(long long)(test_rng()() >> 2) * (test_rng()() % 2 ? 1 : -1));
+
+    for (int128 x : values)
+    {
+        for (int128 y : values)
+        {
+            BigInt a = from_int128(x), b = from_int128(y);
+            std::string pair = int128_string(x) + ", " + int128_string(y);
+            check((a + b).to_string() == int128_string(x + y), "+ " + pair);
+            check((a - b).to_string() == int128_string(x - y), "- " + pair);
+            check((a * b).to_string() == int128_string(x * y), "* " + pair);
+            if (y != 0)
+            {
+                check((a / b).to_string() == int128_string(x / y), "/ " + pair);
+                check((a % b).to_string() == int128_string(x % y), "% " + pair);
+            }
+            check((a < b) == (x < y) && (a == b) == (x == y), "compare " + pair);
+        }
+    }
+
+    // Carries across the limb boundary and into a third limb
+    BigInt top = BigInt("340282366920938463463374607431768211455"); // 2^128 - 1
+    check((top + 1).to_string() == "340282366920938463463374607431768211456", "2^128 - 1 + 1");
+    check((top + 1 - 1) == top, "2^128 - 1 + 1 - 1");
+    check((BigInt("18446744073709551615") + 1).to_string() == "18446744073709551616", "2^64 - 1 + 1");
+    check((BigInt("18446744073709551616") - 1).to_string() == "18446744073709551615", "2^64 - 1");
+
+    // Arithmetic on small values makes no heap allocation
+    CountingAllocator counter;
+    {
+        BigIntAllocatorScope scope(counter);
+        BigInt a = 123456789, b = -987654321, c;
+        for (int i = 0; i < 1000; i++)
+        {
+            c = a * b + i;
+            c -= a;
+            c = c / 7 % 1000000007;
+            ++a;
+        }
+        BigInt wide = BigInt(1) << 127;
+        wide -= 1;
+        c = wide / 3 + wide % 5;
+    }
+    check(counter.allocations == 0, "allocations of small values: " + std::to_string(counter.allocations));
+
+    return finish("small_values");
+}
@@ -0,0 +1,61 @@
+/*
+    squaring
+    --------
+    The squaring kernels of every tier against the schoolbook product of
+    the operand with a copy of itself, which takes the general path.
+
+        g++ -std=c++14 -O2 tests/squaring.cpp -o squaring && ./squaring
+*/
+
+#include "check.h"
+
+void check_sqr(size_t n, const char *what)
+{
+    Limbs a = random_limbs(n), copy = a, r(2 * n), expected(2 * n);
+    sqr(r.data(), a.data(), n);
+    mul_basecase(expected.data(), a.data(), n, copy.data(), n);
+    check(same_limbs(r, expected), limbs_name(what, n, n));
+
+    // mul() spots the shared operand and squares
+    mul(r.data(), a.data(), n, a.data(), n);
+    check(same_limbs(r, expected), limbs_name(what, n, n) + " through mul");
+}
+
+struct Tier
+{
+    const char *name;
+    size_t karatsuba, toom3, toom4, fft;
+};
+
+int main()
+{
+    const Tier tiers[] = {
+        {"sqr_basecase", SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX},
+        {"sqr_karatsuba", 2, SIZE_MAX, SIZE_MAX, SIZE_MAX},
+        {"toom3 square", 2, 3, SIZE_MAX, SIZE_MAX},
+        {"toom4 square", 2, 3, 3, SIZE_MAX},
+        {"fft square", 2, 3, 3, 3},
+        {"mixed square", 3, 7, 19, 45},
+    };
+
+    for (const Tier &tier : tiers)
+    {
+        ThresholdScope thresholds;
+        KARATSUBA_THRESHOLD = tier.karatsuba, TOOM3_THRESHOLD = tier.toom3;
+        TOOM4_THRESHOLD = tier.toom4, FFT_THRESHOLD = tier.fft;
+        for (size_t n = 1; n <= 80; n++)
+            check_sqr(n, tier.name);
+        check_sqr(300, tier.name);
+    }
+
+    // The public forms, with the default thresholds
+    for (size_t n : {1, 2, 3, 40, 250, 700, 2100})
+    {
+        BigInt x = random_bigint(n), copy = x + 0;
+        BigInt expected = x * (copy + 1) - copy;
+        check(x.square() == expected, "square() of " + std::to_string(n) + " limbs");
+        check(x * x == expected, "x * x of " + std::to_string(n) + " limbs");
+    }
+
+    return finish("squaring");
+}
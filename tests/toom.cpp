@@ -0,0 +1,51 @@
+/*
+    toom
+    ----
+    Toom-3 and Toom-4 multiplication against the schoolbook product, each
+    tier alone and nested, with the thresholds forced low so that the
+    evaluation points see short, carry heavy and unbalanced pieces.
+
+        g++ -std=c++14 -O2 tests/toom.cpp -o toom && ./toom
+*/
+
+#include "check.h"
+
+void check_sizes(const char *what)
+{
+    for (size_t an = 1; an <= 90; an++)
+    {
+        for (size_t bn : {an, an - an / 4, (an + 1) / 2 + 1, (an + 1) / 2, an / 3 + 1, (size_t)2})
+            if (bn >= 1 && bn <= an)
+                check_mul(an, bn, what);
+    }
+    check_mul(400, 400, what);
+    check_mul(400, 201, what);
+    check_mul(1500, 90, what);
+}
+
+int main()
+{
+    ThresholdScope thresholds;
+    FFT_THRESHOLD = SIZE_MAX;
+
+    // Toom-3 over a basecase, then over Karatsuba
+    TOOM4_THRESHOLD = SIZE_MAX;
+    for (size_t threshold : {2, 3, 5, 8})
+    {
+        KARATSUBA_THRESHOLD = TOOM3_THRESHOLD = threshold;
+        check_sizes("toom3");
+    }
+    KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 6;
+    check_sizes("toom3 over karatsuba");
+
+    // Toom-4 over a basecase, then over both lower tiers
+    for (size_t threshold : {2, 3, 4, 9})
+    {
+        KARATSUBA_THRESHOLD = TOOM3_THRESHOLD = TOOM4_THRESHOLD = threshold;
+        check_sizes("toom4");
+    }
+    KARATSUBA_THRESHOLD = 2, TOOM3_THRESHOLD = 5, TOOM4_THRESHOLD = 12;
+    check_sizes("toom4 over toom3");
+
+    return finish("toom");
+}
@@ -0,0 +1,91 @@
+/*
+    word_ops
+    --------
+    The single limb kernels behind BigInt op long long against the general
+    BigInt op BigInt, in every form, for the words at the ends of the range,
+    and without allocating when the result fits the storage it goes into.
+
+        g++ -std=c++14 -O2 tests/word_ops.cpp -o word_ops && ./word_ops
+*/
+
+#include "check.h"
+#include <climits>
+
+int main()
+{
+    std::vector<long long> words = {0, 1, -1, 2, -2, 3, 10, -10, 1000000007, -999999999989LL,
+                                    LLONG_MAX, LLONG_MIN, LLONG_MIN + 1, 1LL << 32, -(1LL << 62)};
+    for (int i = 0; i < 10; i++)
+        words.push_back((long long)test_rng()());
+
+    std::vector<BigInt> values = {0, 1, -1, LLONG_MAX, LLONG_MIN, BigInt(LLONG_MIN) * 2};
+    for (size_t n = 1; n <= 6; n++)
+    {
+        values.push_back(random_bigint(n));
+        values.push_back(-(BigInt(1) << (64 * n)));
+    }
+
+    for (const BigInt &a : values)
+    {
+        for (long long w : words)
+        {
+            const BigInt b = w;
+            std::string pair = a.to_string() + ", " + std::to_string(w);
+
+            check(a + w == a + b && w + a == b + a, "+ " + pair);
+            check(a - w == a - b && w - a == b - a, "- " + pair);
+            check(a * w == a * b && w * a == b * a, "* " + pair);
+            check(BigInt(a) + w == a + b && BigInt(a) - w == a - b && BigInt(a) * w == a * b,
+                  "rvalue op " + pair);
+
+            BigInt x = a;
+            x += w;
+            check(x == a + b, "+= " + pair);
+            x = a, x -= w;
+            check(x == a - b, "-= " + pair);
+            x = a, x *= w;
+            check(x == a * b, "*= " + pair);
+            x = 5, x.addmul(a, w);
+            check(x == 5 + a * b, "addmul " + pair);
+            x = 5, x.submul(a, w);
+            check(x == 5 - a * b, "submul " + pair);
+
+            if (w != 0)
+            {
+                check(a / w == a / b && BigInt(a) / w == a / b, "/ " + pair);
+                check(a % w == a % b, "% " + pair);
+                x = a, x /= w;
+                check(x == a / b, "/= " + pair);
+                x = a, x %= w;
+                check(x == a % b, "%= " + pair);
+            }
+            if (a != 0)
+                check(w / a == b / a && w % a == b % a, "word / and % " + pair);
+
+            check((a < w) == (a < b) && (a > w) == (a > b) && (a <= w) == (a <= b) &&
+                      (a >= w) == (a >= b) && (a == w) == (a == b) && (a != w) == (a != b),
+                  "compare " + pair);
+            check((w < a) == (b < a) && (w == a) == (b == a), "word compare " + pair);
+        }
+    }
+
+    // In place word operations on a heap value stay in its buffer
+    BigInt big = pow(BigInt(3), 1000), expected = big, rem;
+    CountingAllocator counter;
+    {
+        BigIntAllocatorScope scope(counter);
+        for (int i = 1; i < 100; i++)
+        {
+            big += i;
+            big -= i;
+            big *= 3;
+            big /= 3;
+        }
+        rem = big % 1000003;
+        big %= LLONG_MAX;
+    }
+    check(counter.allocations == 0, "word operations allocate: " + std::to_string(counter.allocations));
+    check(rem == expected % BigInt(1000003) && big == expected % BigInt(LLONG_MAX), "in place word operations");
+
+    return finish("word_ops");
+}